@@ -78,23 +78,30 @@ extern char system_log_buf[SYSTEM_TRACE_BUF_SZ]; /*!< buffer for debug traces */
   * @{
   */
 #if defined (__LOG_TRACE_IO_) || defined(__LOG_UART_IO_)
+/* one tick read per line: seconds and milliseconds of the same instant */
+#define log_print(tag, fmt, ...) \
+  do { \
+    uint32_t log_tick = HAL_GetTick(); \
+    printf("[%05ld.%03ld][" tag "]" fmt, (long)(log_tick / 1000), \
+           (long)(log_tick % 1000), ##__VA_ARGS__); \
+  } while (0)
 #if LOGLEVEL >= LOGDBG
-#define log_dbg(fmt, ...)  printf("[%05ld.%03ld][DBG  ]" fmt, HAL_GetTick()/1000, HAL_GetTick() % 1000, ##__VA_ARGS__)
+#define log_dbg(fmt, ...)  log_print("DBG  ", fmt, ##__VA_ARGS__)
 #else
 #define log_dbg(fmt, ...)
 #endif
 #if LOGLEVEL >= LOGINFO
-#define log_info(fmt, ...) printf("[%05ld.%03ld][INFO ]" fmt, HAL_GetTick()/1000, HAL_GetTick() % 1000, ##__VA_ARGS__)
+#define log_info(fmt, ...) log_print("INFO ", fmt, ##__VA_ARGS__)
 #else
 #define log_info(fmt, ...)
 #endif
 #if LOGLEVEL >= LOGWARN
-#define log_warn(fmt, ...) printf("[%05ld.%03ld][WARN ]" fmt, HAL_GetTick()/1000, HAL_GetTick() % 1000, ##__VA_ARGS__)
+#define log_warn(fmt, ...) log_print("WARN ", fmt, ##__VA_ARGS__)
 #else
 #define log_warn(fmt, ...)
 #endif
 #if LOGLEVEL >= LOGERR
-#define log_err(fmt, ...)  printf("[%05ld.%03ld][ERR  ]" fmt, HAL_GetTick()/1000, HAL_GetTick() % 1000, ##__VA_ARGS__)
+#define log_err(fmt, ...)  log_print("ERR  ", fmt, ##__VA_ARGS__)
 #else
 #define log_err(fmt, ...)
 #endif
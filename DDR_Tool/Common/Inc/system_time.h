@@ -33,8 +33,11 @@
 /* Exported functions ------------------------------------------------------- */
 
 void delay_us(unsigned long delay_us);
-__IO uint32_t timeout_init_us(unsigned long timeout_us);
-bool timeout_elapsed(__IO uint32_t timeout);
+uint64_t timeout_init_us(unsigned long timeout_us);
+bool timeout_elapsed(uint64_t timeout);
+uint64_t timer_get_count(void);
+uint32_t timer_get_freq(void);
+uint64_t timer_ticks_to_us(uint64_t ticks);
 
 #ifdef __cplusplus
 }
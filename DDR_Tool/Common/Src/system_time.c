@@ -36,49 +36,68 @@
 /* Private functions ---------------------------------------------------------*/
 
 /**
-  * @brief  This function handles delay service.
+  * @brief  This function handles delay service, on the generic timer.
   * @param  delay_us: delay in microseconds
   * @retval None
   */
 void delay_us(unsigned long delay_us)
 {
-  __IO uint32_t wait_loop_index = 0U;
-
-  wait_loop_index = (delay_us * (SystemCoreClock / (1000000UL * 2UL)));
-
-  while(wait_loop_index != 0UL)
-  {
-    wait_loop_index--;
-  }
+  HAL_DelayUs((uint32_t)delay_us);
 }
 
 /**
   * @brief  This function handles timeout initialization service.
-  * @param  delay_us: timeout in microseconds
-  * @retval None
+  * @param  timeout_us: timeout in microseconds
+  * @retval End of the timeout, for timeout_elapsed()
+  */
+uint64_t timeout_init_us(unsigned long timeout_us)
+{
+  return HAL_TimeoutInitUs((uint32_t)timeout_us);
+}
+
+/**
+  * @brief  This function handles timeout elapsed checking service.
+  * @param  timeout: value returned by timeout_init_us()
+  * @retval true when the timeout is elapsed
   */
-__IO uint32_t timeout_init_us(unsigned long timeout_us)
+bool timeout_elapsed(uint64_t timeout)
 {
-  __IO uint32_t wait_loop_index = 0U;
+  return HAL_IsTimeoutElapsed(timeout) != 0U;
+}
 
-  wait_loop_index = timeout_us * (SystemCoreClock / (1000000UL * 2UL));
+/**
+  * @brief  This function returns the generic timer physical count.
+  * @retval Counter value, incremented at timer_get_freq() Hz
+  */
+uint64_t timer_get_count(void)
+{
+  return HAL_GetTimerCount();
+}
 
-  return wait_loop_index;
+/**
+  * @brief  This function returns the generic timer frequency.
+  * @retval Frequency in Hz (STGEN frequency programmed in CNTFRQ)
+  */
+uint32_t timer_get_freq(void)
+{
+  return HAL_GetTimerFreq();
 }
 
 /**
-  * @brief  This function handles timeout elapsed checking service.
-  * @param  delay_us: timeout in microseconds
-  * @retval None
+  * @brief  This function converts generic timer ticks in microseconds.
+  * @param  ticks: number of ticks at timer_get_freq() Hz
+  * @retval Duration in microseconds, 0 if the timer frequency is not set
   */
-bool timeout_elapsed(__IO uint32_t timeout)
+uint64_t timer_ticks_to_us(uint64_t ticks)
 {
-  if (timeout == 0U)
+  uint64_t freq = timer_get_freq();
+
+  if (freq == 0U)
   {
-    return true;
+    return 0U;
   }
 
-  return false;
+  return ((ticks / freq) * 1000000U) + (((ticks % freq) * 1000000U) / freq);
 }
 
 /**
@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    stm32_device_hal.h
+  * @author  MCD Application Team
+  * @brief   Host replacement of the HAL device definitions used by the DDR
+  *          test engine (DDR_Tool/<board>/Src/ddr_tests.c).
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM32_DEVICE_HAL_H
+#define __STM32_DEVICE_HAL_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+#define __IO volatile
+
+/* Only the DDRC registers read by the test engine are modelled */
+typedef struct
+{
+  __IO uint32_t MSTR;
+  __IO uint32_t ADDRMAP0;
+  __IO uint32_t ADDRMAP1;
+  __IO uint32_t ADDRMAP2;
+  __IO uint32_t ADDRMAP3;
+  __IO uint32_t ADDRMAP4;
+  __IO uint32_t ADDRMAP5;
+  __IO uint32_t ADDRMAP6;
+  __IO uint32_t ADDRMAP7;
+  __IO uint32_t ADDRMAP8;
+  __IO uint32_t ADDRMAP9;
+  __IO uint32_t ADDRMAP10;
+  __IO uint32_t ADDRMAP11;
+} DDRC_TypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define DDRC_MSTR_DATA_BUS_WIDTH_Pos (12U)
+#define DDRC_MSTR_DATA_BUS_WIDTH_Msk (0x3UL << DDRC_MSTR_DATA_BUS_WIDTH_Pos)
+#define DDRC_MSTR_DATA_BUS_WIDTH_0   (0x1UL << DDRC_MSTR_DATA_BUS_WIDTH_Pos)
+#define DDRC_MSTR_DATA_BUS_WIDTH_1   (0x2UL << DDRC_MSTR_DATA_BUS_WIDTH_Pos)
+
+/* Exported variables --------------------------------------------------------*/
+/* Simulated DDR backing store, set up by ddr_host.c */
+extern DDRC_TypeDef ddr_host_ddrc;
+extern unsigned long ddr_host_base;
+extern unsigned long ddr_host_size;
+
+#define DDRC                         (&ddr_host_ddrc)
+#define DDR_MEM_BASE                 ddr_host_base
+
+/* Exported macro ------------------------------------------------------------*/
+#define READ_REG(REG)                ((REG))
+#define WRITE_REG(REG, VAL)          ((REG) = (VAL))
+
+#endif /* __STM32_DEVICE_HAL_H */
@@ -0,0 +1,23 @@
+/**
+  ******************************************************************************
+  * @file    stm32mp_util_conf.h
+  * @author  MCD Application Team
+  * @brief   Host replacement of the util configuration: no UART, no PMIC.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM32MP_UTIL_CONF_H
+#define __STM32MP_UTIL_CONF_H
+
+#endif /* __STM32MP_UTIL_CONF_H */
@@ -0,0 +1,27 @@
+/**
+  ******************************************************************************
+  * @file    stm32mp_util_ddr_conf.h
+  * @author  MCD Application Team
+  * @brief   Host replacement of the util DDR configuration: the DDR size is
+  *          the size of the buffer mapped by ddr_host.c.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM32MP_UTIL_DDR_CONF_H
+#define __STM32MP_UTIL_DDR_CONF_H
+
+#define DDR_MEM_NAME  "host simulated DDR"
+#define DDR_MEM_SIZE  ddr_host_size
+
+#endif /* __STM32MP_UTIL_DDR_CONF_H */
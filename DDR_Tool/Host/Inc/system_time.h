@@ -0,0 +1,30 @@
+/**
+  ******************************************************************************
+  * @file    system_time.h
+  * @author  MCD Application Team
+  * @brief   Host replacement of the time services: the generic timer is
+  *          replaced by the monotonic clock, implemented in ddr_host.c.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SYSTEM_TIME_H
+#define __SYSTEM_TIME_H
+
+#include <stdint.h>
+
+uint64_t timer_get_count(void);
+uint32_t timer_get_freq(void);
+uint64_t timer_ticks_to_us(uint64_t ticks);
+
+#endif /* __SYSTEM_TIME_H */
@@ -0,0 +1,447 @@
+/**
+  ******************************************************************************
+  * @file    ddr_host.c
+  * @author  MCD Application Team
+  * @brief   Linux host runner of the DDR test engine: the DDR_Test_* functions
+  *          of ddr_tests.c are executed on an mmap'd buffer which stands in
+  *          for DDR_MEM_BASE/DDR_MEM_SIZE.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_device_hal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "ddr_tests.h"
+#include "ddr_tool_tlm.h"
+#include "system_time.h"
+#include "stm32mp_util_ddr_conf.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint32_t (*fct)();
+  const char *name;
+  uint8_t max_args;
+} host_test_desc;
+
+/* Private define ------------------------------------------------------------*/
+#define DDR_BASE_ADDR       0x80000000UL
+#define HOST_DFLT_SIZE      0x10000000UL
+#define HOST_HUGEPAGE_SIZE  0x200000UL
+
+/* Same numbering as the test[] table of ddr_tool.c, 0 is "Test All" */
+static const host_test_desc host_test[] = {
+  {NULL, "Test All", 3},
+  {DDR_Test_Databus, "Test Simple DataBus", 1},
+  {DDR_Test_DatabusWalk0, "Test DataBusWalking0", 2},
+  {DDR_Test_DatabusWalk1, "Test DataBusWalking1", 2},
+  {DDR_Test_AddressBus, "Test AddressBus", 2},
+  {DDR_Test_MemDevice, "Test MemDevice", 2},
+  {DDR_Test_SimultaneousSwitchingOutput, "Test SimultaneousSwitchingOutput", 2},
+  {DDR_Test_Noise, "Test Noise", 2},
+  {DDR_Test_NoiseBurst, "Test NoiseBurst", 3},
+  {DDR_Test_Random, "Test Random", 3},
+  {DDR_Test_FrequencySelectivePattern, "Test FrequencySelectivePattern", 2},
+  {DDR_Test_BlockSequential, "Test BlockSequential", 3},
+  {DDR_Test_Checkerboard, "Test Checkerboard", 3},
+  {DDR_Test_BitSpread, "Test BitSpread", 3},
+  {DDR_Test_BitFlip, "Test BitFlip", 3},
+  {DDR_Test_WalkingZeroes, "Test WalkingZeroes", 3},
+  {DDR_Test_WalkingOnes, "Test WalkingOnes", 3},
+  {DDR_Test_CacheLine, "Test CacheLine", 3},
+  {DDR_Test_MarchCMinus, "Test MarchC-", 3},
+  {DDR_Test_MarchSS, "Test MarchSS", 3},
+  {DDR_Test_MatsPlus, "Test MATS+", 3},
+  {DDR_Test_PerBank, "Test PerBank", 3},
+  {DDR_Test_PerRow, "Test PerRow", 3},
+  {DDR_Test_RowConflict, "Test RowConflict", 3},
+  {DDR_Test_Stream, "Test Stream", 3},
+};
+
+static const int host_test_nb = sizeof(host_test) / sizeof(host_test[0]);
+
+/* Exported variables --------------------------------------------------------*/
+DDRC_TypeDef ddr_host_ddrc;
+unsigned long ddr_host_base;
+unsigned long ddr_host_size;
+
+/* Private functions ---------------------------------------------------------*/
+static void usage(const char *prog)
+{
+  int i;
+
+  printf("usage: %s [-s size] [-H] [-w 16|32] [-c] [-r seed] [-t] <test> "
+         "[arg]...\n", prog);
+  printf("  -s size  size of the simulated DDR (default 0x%lx)\n",
+         HOST_DFLT_SIZE);
+  printf("  -H       back the simulated DDR with huge pages\n");
+  printf("  -w width DDR data bus width seen by the tests (default 32)\n");
+  printf("  -c       continue on error, report errors per lane and DQ bit\n");
+  printf("  -r seed  seed of the random tests (default: fixed seed)\n");
+  printf("  -t       telemetry frames instead of the text results, decoded\n"
+         "           by ddr_tlm\n");
+  printf("  [addr] arguments are DDR addresses from 0x%lx, 0 = DDR base\n",
+         DDR_BASE_ADDR);
+  printf("tests (same arguments as the 'test' command of DDR_Tool):\n");
+  for (i = 0; i < host_test_nb; i++)
+  {
+    printf("  %2d: %s\n", i, host_test[i].name);
+  }
+}
+
+static double host_time(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int host_map(unsigned long size, int hugepage)
+{
+  unsigned long map_size = size + HOST_HUGEPAGE_SIZE;
+  void *buf = MAP_FAILED;
+
+  if (hugepage)
+  {
+    buf = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+               -1, 0);
+    if (buf == MAP_FAILED)
+    {
+      printf("MAP_HUGETLB failed, falling back to transparent huge pages\n");
+    }
+  }
+
+  if (buf == MAP_FAILED)
+  {
+    buf = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (buf == MAP_FAILED)
+    {
+      perror("mmap");
+      return -1;
+    }
+
+    if (hugepage)
+    {
+      (void)madvise(buf, map_size, MADV_HUGEPAGE);
+    }
+  }
+
+  /* Keep the DDR base aligned as on target (huge page boundary) */
+  ddr_host_base = ((unsigned long)buf + HOST_HUGEPAGE_SIZE - 1) &
+                  ~(HOST_HUGEPAGE_SIZE - 1);
+  ddr_host_size = size;
+
+  return 0;
+}
+
+/* Translate a DDR address argument in the simulated DDR, 0 stays default */
+static int host_addr(unsigned long addr_in, unsigned long *addr)
+{
+  if (addr_in == 0UL)
+  {
+    *addr = 0UL;
+    return 0;
+  }
+
+  if ((addr_in < DDR_BASE_ADDR) || (addr_in >= DDR_BASE_ADDR + ddr_host_size))
+  {
+    printf("Address out of the simulated DDR: 0x%lx\n", addr_in);
+    return -1;
+  }
+
+  *addr = ddr_host_base + (addr_in - DDR_BASE_ADDR);
+
+  return 0;
+}
+
+/* Same report as print_test_stats() of ddr_tool.c */
+static void host_print_stats(int id, uint32_t ret, double elapsed,
+                             const ddr_test_stats *start)
+{
+  ddr_test_stats stats;
+  unsigned long written;
+  unsigned long read;
+  unsigned long elapsed_us = (unsigned long)(elapsed * 1e6);
+  unsigned long bandwidth = 0;
+
+  DDR_Test_Stats_Get(&stats);
+  written = stats.written - start->written;
+  read = stats.read - start->read;
+
+  if (DDR_Tlm_Get_Enable())
+  {
+    DDR_Tlm_Result(id, DDR_Test_Get_Cache() ? DDR_TLM_FLAG_WB : 0U, ret, 0,
+                   written, read, elapsed_us, host_test[id].name,
+                   DDR_MEM_NAME);
+    return;
+  }
+
+  if (elapsed_us != 0U)
+  {
+    bandwidth = (written + read) / elapsed_us;
+  }
+
+  printf("  written %lu bytes, read %lu bytes in %lu.%06lu s => %lu MB/s\n",
+         written, read, elapsed_us / 1000000, elapsed_us % 1000000, bandwidth);
+  printf("PERF;%d;%s;%d;%lu;%lu;%lu;%lu;%s;%d;%s\n", id, host_test[id].name,
+         ret, written, read, elapsed_us, bandwidth, DDR_MEM_NAME, 0,
+         DDR_Test_Get_Cache() ? "WB" : "NC");
+}
+
+static uint32_t host_run(int i, const unsigned long *arg)
+{
+  switch (host_test[i].max_args)
+  {
+    case 1:
+      return host_test[i].fct(arg[0]);
+    case 2:
+      return host_test[i].fct(arg[0], arg[1]);
+    case 3:
+      return host_test[i].fct(arg[0], arg[1], arg[2]);
+    default:
+      return 0xFF;
+  }
+}
+
+/* Same sequence and argument mapping as DDR_Test_All() of ddr_tool.c */
+static uint32_t host_test_all(unsigned long loop, unsigned long size,
+                              unsigned long addr)
+{
+  unsigned long arg[3];
+  ddr_test_stats stats;
+  uint32_t result = 0;
+  uint32_t ret;
+  double start;
+  int i;
+
+  for (i = 1; i < host_test_nb; i++)
+  {
+    switch (host_test[i].max_args)
+    {
+      case 1:
+        arg[0] = addr;
+        break;
+      case 2:
+        if (   (host_test[i].fct == DDR_Test_DatabusWalk0)
+            || (host_test[i].fct == DDR_Test_DatabusWalk1))
+        {
+          arg[0] = loop;
+        }
+        else if (host_test[i].fct == DDR_Test_Noise)
+        {
+          arg[0] = 0;
+        }
+        else
+        {
+          arg[0] = size;
+        }
+        arg[1] = addr;
+        break;
+      case 3:
+        arg[0] = ((host_test[i].fct == DDR_Test_PerBank) ||
+                  (host_test[i].fct == DDR_Test_PerRow) ||
+                  (host_test[i].fct == DDR_Test_RowConflict)) ? 0 : size;
+        arg[1] = (host_test[i].fct == DDR_Test_NoiseBurst) ? 0 : loop;
+        arg[2] = addr;
+        break;
+    }
+
+    DDR_Test_Stats_Get(&stats);
+    DDR_Test_Errors_Reset();
+    start = host_time();
+    ret = host_run(i, arg);
+    if ((DDR_Test_Errors_Report() != 0U) && (ret == 0U))
+    {
+      ret = DDR_TEST_ERRORS_ACCUMULATED;
+    }
+
+    if (ret != 0)
+    {
+      printf("%s failed [%d]\n", host_test[i].name, ret);
+      host_print_stats(i, ret, host_time() - start, &stats);
+      if (!DDR_Test_Get_Continue())
+      {
+        return ret;
+      }
+
+      result = ret;
+      continue;
+    }
+
+    printf("result %d:%s = Passed\n", i, host_test[i].name);
+    host_print_stats(i, ret, host_time() - start, &stats);
+  }
+
+  return result;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/* The generic timer of the target is replaced by a 1 GHz monotonic clock */
+uint64_t timer_get_count(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint32_t timer_get_freq(void)
+{
+  return 1000000000U;
+}
+
+uint64_t timer_ticks_to_us(uint64_t ticks)
+{
+  return ticks / 1000U;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned long size = HOST_DFLT_SIZE;
+  unsigned long arg[3] = {0, 0, 0};
+  ddr_test_stats stats = {0, 0};
+  int hugepage = 0;
+  int width = 32;
+  int nb_args;
+  int opt;
+  int id;
+  int i;
+  uint32_t ret;
+  double start;
+  double elapsed;
+
+  setvbuf(stdout, NULL, _IOLBF, 0);
+
+  while ((opt = getopt(argc, argv, "s:Hw:cr:th")) != -1)
+  {
+    switch (opt)
+    {
+      case 's':
+        size = strtoul(optarg, NULL, 0);
+        break;
+      case 'H':
+        hugepage = 1;
+        break;
+      case 'w':
+        width = atoi(optarg);
+        break;
+      case 'c':
+        DDR_Test_Set_Continue(true);
+        break;
+      case 'r':
+        DDR_Test_Set_Seed(strtoul(optarg, NULL, 0));
+        break;
+      case 't':
+        DDR_Tlm_Set_Enable(true);
+        break;
+      default:
+        usage(argv[0]);
+        return opt == 'h' ? 0 : 1;
+    }
+  }
+
+  if ((optind >= argc) || (size == 0UL) ||
+      ((width != 16) && (width != 32)))
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  id = atoi(argv[optind++]);
+  nb_args = argc - optind;
+  if ((id < 0) || (id >= host_test_nb) || (nb_args > host_test[id].max_args) ||
+      ((id != 0) && (nb_args != 0) && (nb_args != host_test[id].max_args)))
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  for (i = 0; i < nb_args; i++)
+  {
+    arg[i] = strtoul(argv[optind + i], NULL, 0);
+  }
+
+  if (host_map(size, hugepage) != 0)
+  {
+    return 1;
+  }
+
+  ddr_host_ddrc.MSTR = (width == 16) ? DDRC_MSTR_DATA_BUS_WIDTH_0 : 0U;
+
+  /* address map of the DDR4 template (RBC: row/bank/column) */
+  ddr_host_ddrc.ADDRMAP0 = 0x0000001FU;
+  ddr_host_ddrc.ADDRMAP1 = 0x003F0909U;
+  ddr_host_ddrc.ADDRMAP2 = 0x00000000U;
+  ddr_host_ddrc.ADDRMAP3 = 0x00000000U;
+  ddr_host_ddrc.ADDRMAP4 = 0x00001F1FU;
+  ddr_host_ddrc.ADDRMAP5 = 0x070F0707U;
+  ddr_host_ddrc.ADDRMAP6 = 0x07070707U;
+  ddr_host_ddrc.ADDRMAP7 = 0x00000F07U;
+  ddr_host_ddrc.ADDRMAP8 = 0x00003F08U;
+  ddr_host_ddrc.ADDRMAP9 = 0x07070707U;
+  ddr_host_ddrc.ADDRMAP10 = 0x07070707U;
+  ddr_host_ddrc.ADDRMAP11 = 0x00000007U;
+
+  printf("DDR simulated: 0x%lx bytes @ %p, %d bits\n", ddr_host_size,
+         (void *)ddr_host_base, width);
+
+  /* The address is always the last argument */
+  if (host_addr(arg[host_test[id].max_args - 1],
+                &arg[host_test[id].max_args - 1]) != 0)
+  {
+    return 1;
+  }
+
+  DDR_Test_Stats_Reset();
+  DDR_Test_Errors_Reset();
+  start = host_time();
+  if (id == 0)
+  {
+    ret = host_test_all(arg[0], arg[1], arg[2]);
+  }
+  else
+  {
+    ret = host_run(id, arg);
+    if ((DDR_Test_Errors_Report() != 0U) && (ret == 0U))
+    {
+      ret = DDR_TEST_ERRORS_ACCUMULATED;
+    }
+  }
+
+  elapsed = host_time() - start;
+
+  if (ret != 0)
+  {
+    printf("%s failed [%d]\n", host_test[id].name, ret);
+  }
+  else
+  {
+    printf("Result: Pass [%s]\n", host_test[id].name);
+  }
+
+  host_print_stats(id, ret, elapsed, &stats);
+
+  return (ret != 0) ? 2 : 0;
+}
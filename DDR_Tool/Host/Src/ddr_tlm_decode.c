@@ -0,0 +1,405 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tlm_decode.c
+  * @author  MCD Application Team
+  * @brief   Linux host decoder of the telemetry frames of ddr_tool_tlm.c,
+  *          read on stdin (console capture of DDR_Tool with "tlm on" or
+  *          output of ddr_host -t): the records are printed as the text
+  *          lines of the tests (PERF, STREAM, LAT...), the other bytes are
+  *          copied as they are.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ddr_tool_tlm.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+  TLM_OUT_ALL = 0,      /* text and records */
+  TLM_OUT_RECORDS,      /* records only */
+  TLM_OUT_DEFINES,      /* registers only, as the "save" command */
+} tlm_out;
+
+typedef struct {
+  char *base;
+  char *section;
+  char *name;
+} tlm_reg_name;
+
+/* Private define ------------------------------------------------------------*/
+#define TLM_REG_MAX             0x10000
+
+/* Private variables ---------------------------------------------------------*/
+static tlm_out out_mode = TLM_OUT_ALL;
+static tlm_reg_name reg_name[TLM_REG_MAX];
+static const char *last_section;
+static unsigned long frame_nb;
+static unsigned long crc_errors;
+
+/* Private functions ---------------------------------------------------------*/
+static void usage(const char *prog)
+{
+  printf("usage: %s [-c|-d] < capture\n", prog);
+  printf("  -c       records only, without the console text\n");
+  printf("  -d       registers only, as #define lines of the 'save' command\n");
+}
+
+static uint64_t get_le(const uint8_t **p, const uint8_t *end, unsigned int size)
+{
+  uint64_t value = 0;
+  unsigned int i;
+
+  if (*p + size > end)
+  {
+    *p = end;
+    return 0;
+  }
+
+  for (i = 0; i < size; i++)
+  {
+    value |= (uint64_t)(*p)[i] << (i * 8);
+  }
+  *p += size;
+
+  return value;
+}
+
+/* copy a string of the payload, terminated by '\0' or by the payload end */
+static void get_str(const uint8_t **p, const uint8_t *end, char *str,
+                    size_t max)
+{
+  size_t len = 0;
+
+  while ((*p < end) && (**p != '\0'))
+  {
+    if (len < max - 1)
+    {
+      str[len++] = (char)**p;
+    }
+    (*p)++;
+  }
+  str[len] = '\0';
+
+  if (*p < end)
+  {
+    (*p)++;
+  }
+}
+
+static void decode_result(const uint8_t *p, const uint8_t *end)
+{
+  char test_name[DDR_TLM_PAYLOAD_MAX];
+  char ddr_name[DDR_TLM_PAYLOAD_MAX];
+  unsigned int id = (unsigned int)get_le(&p, end, 1);
+  unsigned int flags = (unsigned int)get_le(&p, end, 1);
+  uint32_t result = (uint32_t)get_le(&p, end, 4);
+  uint32_t speed = (uint32_t)get_le(&p, end, 4);
+  unsigned long written = (unsigned long)get_le(&p, end, 8);
+  unsigned long read = (unsigned long)get_le(&p, end, 8);
+  unsigned long elapsed_us = (unsigned long)get_le(&p, end, 8);
+  unsigned long bandwidth = 0;
+
+  get_str(&p, end, test_name, sizeof(test_name));
+  get_str(&p, end, ddr_name, sizeof(ddr_name));
+
+  if (elapsed_us != 0U)
+  {
+    bandwidth = (written + read) / elapsed_us;
+  }
+
+  /* same line as print_test_stats() of ddr_tool.c */
+  printf("PERF;%u;%s;%d;%lu;%lu;%lu;%lu;%s;%u;%s\n", id, test_name,
+         (int)result, written, read, elapsed_us, bandwidth, ddr_name, speed,
+         (flags & DDR_TLM_FLAG_WB) ? "WB" : "NC");
+}
+
+static void decode_error(const uint8_t *p, const uint8_t *end)
+{
+  unsigned int core = (unsigned int)get_le(&p, end, 1);
+  uint64_t addr = get_le(&p, end, 8);
+  uint64_t expected = get_le(&p, end, 8);
+  uint64_t actual = get_le(&p, end, 8);
+
+  printf("ERROR;%u;0x%llx;0x%llx;0x%llx;0x%llx\n", core,
+         (unsigned long long)addr, (unsigned long long)expected,
+         (unsigned long long)actual,
+         (unsigned long long)(expected ^ actual));
+}
+
+static void decode_reg_name(const uint8_t *p, const uint8_t *end)
+{
+  char str[DDR_TLM_PAYLOAD_MAX];
+  unsigned int id = (unsigned int)get_le(&p, end, 2);
+  tlm_reg_name *reg = &reg_name[id];
+
+  free(reg->base);
+  free(reg->section);
+  free(reg->name);
+
+  get_str(&p, end, str, sizeof(str));
+  reg->base = strdup(str);
+  get_str(&p, end, str, sizeof(str));
+  reg->section = strdup(str);
+  get_str(&p, end, str, sizeof(str));
+  reg->name = strdup(str);
+}
+
+static void print_define(const tlm_reg_name *reg, uint32_t value)
+{
+  const char *prefix = strcmp(reg->base, "pll") ? "DDR_" : "DDR_PLL_";
+  const char *c;
+
+  if ((last_section == NULL) || strcmp(last_section, reg->section))
+  {
+    printf("\n/* %s.%s */\n", reg->base, reg->section);
+    last_section = reg->section;
+  }
+
+  printf("#define %s", prefix);
+  for (c = reg->name; *c != '\0'; c++)
+  {
+    putchar(toupper((unsigned char)*c));
+  }
+  printf(" 0x%08X\n", value);
+}
+
+static void decode_reg(const uint8_t *p, const uint8_t *end)
+{
+  unsigned int id = (unsigned int)get_le(&p, end, 2);
+  uint32_t value;
+
+  for (; p + 4 <= end; id++)
+  {
+    value = (uint32_t)get_le(&p, end, 4);
+
+    if ((id >= TLM_REG_MAX) || (reg_name[id].name == NULL))
+    {
+      fprintf(stderr, "ddr_tlm: register %u without name\n", id);
+      continue;
+    }
+
+    if (out_mode == TLM_OUT_DEFINES)
+    {
+      print_define(&reg_name[id], value);
+    }
+    else
+    {
+      printf("REG;%s.%s;%s;0x%08X\n", reg_name[id].base,
+             reg_name[id].section, reg_name[id].name, value);
+    }
+  }
+}
+
+static void decode_sample(const uint8_t *p, const uint8_t *end)
+{
+  char tag[DDR_TLM_PAYLOAD_MAX];
+  char label[DDR_TLM_PAYLOAD_MAX];
+  uint64_t value[DDR_TLM_PAYLOAD_MAX / 8];
+  unsigned int nb = 0;
+  unsigned int i;
+
+  get_str(&p, end, tag, sizeof(tag));
+  get_str(&p, end, label, sizeof(label));
+  while (p + 8 <= end)
+  {
+    value[nb++] = get_le(&p, end, 8);
+  }
+
+  printf("%s;%s", tag, label);
+  for (i = 0; i < nb; i++)
+  {
+    /* the DDR mapping ends the LAT line of ddr_tool_latency.c */
+    if (!strcmp(tag, "LAT") && (i == nb - 1))
+    {
+      printf(";%s", value[i] ? "WB" : "NC");
+    }
+    /* the critical delay difference ends the CDD line and is signed */
+    else if (!strcmp(tag, "CDD") && (i == nb - 1))
+    {
+      printf(";%lld", (long long)value[i]);
+    }
+    else
+    {
+      printf(";%llu", (unsigned long long)value[i]);
+    }
+  }
+  printf("\n");
+}
+
+static void decode_frame(const uint8_t *frame, size_t len)
+{
+  const uint8_t *p = frame + DDR_TLM_HEADER_SIZE;
+  const uint8_t *end = p + len;
+  ddr_tlm_type type = (ddr_tlm_type)frame[2];
+
+  frame_nb++;
+
+  if (type == DDR_TLM_REG_NAME)
+  {
+    decode_reg_name(p, end);
+    return;
+  }
+
+  if (type == DDR_TLM_REG)
+  {
+    decode_reg(p, end);
+    return;
+  }
+
+  if (out_mode == TLM_OUT_DEFINES)
+  {
+    return;
+  }
+
+  switch (type)
+  {
+    case DDR_TLM_RESULT:
+      decode_result(p, end);
+      break;
+    case DDR_TLM_ERROR:
+      decode_error(p, end);
+      break;
+    case DDR_TLM_SAMPLE:
+      decode_sample(p, end);
+      break;
+    default:
+      fprintf(stderr, "ddr_tlm: unknown record %d\n", type);
+      break;
+  }
+}
+
+static void text_byte(uint8_t c)
+{
+  if (out_mode == TLM_OUT_ALL)
+  {
+    putchar(c);
+  }
+}
+
+/* consume the first byte of buf as text */
+static void text_shift(uint8_t *buf, size_t *len)
+{
+  text_byte(buf[0]);
+  (*len)--;
+  memmove(buf, buf + 1, *len);
+}
+
+/*
+ * Decode the frame or the text byte at the start of buf[0..*len). A frame is
+ * accepted only with its sync, a valid length and its CRC: on a mismatch, its
+ * first byte is text and the next sync is searched from the following byte.
+ * Return false when more bytes are needed, never with a full buffer.
+ */
+static int decode(uint8_t *buf, size_t *len)
+{
+  size_t payload;
+  size_t frame_len;
+  uint16_t crc;
+
+  if ((buf[0] != DDR_TLM_SYNC0) ||
+      ((*len >= 2) && (buf[1] != DDR_TLM_SYNC1)))
+  {
+    goto text;
+  }
+
+  if (*len < DDR_TLM_HEADER_SIZE)
+  {
+    return 0;
+  }
+
+  payload = buf[3] | ((size_t)buf[4] << 8);
+  if (payload > DDR_TLM_PAYLOAD_MAX)
+  {
+    goto text;
+  }
+
+  frame_len = DDR_TLM_HEADER_SIZE + payload + DDR_TLM_CRC_SIZE;
+  if (*len < frame_len)
+  {
+    return 0;
+  }
+
+  crc = buf[frame_len - 2] | (uint16_t)(buf[frame_len - 1] << 8);
+  if (DDR_Tlm_Crc(&buf[2], frame_len - 4) != crc)
+  {
+    crc_errors++;
+    goto text;
+  }
+
+  decode_frame(buf, payload);
+  *len -= frame_len;
+  memmove(buf, buf + frame_len, *len);
+
+  return 1;
+
+text:
+  text_shift(buf, len);
+
+  return 1;
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  uint8_t buf[DDR_TLM_FRAME_MAX];
+  size_t len = 0;
+  int opt;
+  int c;
+
+  while ((opt = getopt(argc, argv, "cdh")) != -1)
+  {
+    switch (opt)
+    {
+      case 'c':
+        out_mode = TLM_OUT_RECORDS;
+        break;
+      case 'd':
+        out_mode = TLM_OUT_DEFINES;
+        break;
+      default:
+        usage(argv[0]);
+        return opt == 'h' ? 0 : 1;
+    }
+  }
+
+  while ((c = getchar()) != EOF)
+  {
+    buf[len++] = (uint8_t)c;
+    while ((len != 0U) && decode(buf, &len))
+    {
+    }
+  }
+
+  /* end of the capture: a frame may still follow an incomplete one */
+  while (len != 0U)
+  {
+    if (!decode(buf, &len))
+    {
+      text_shift(buf, &len);
+    }
+  }
+
+  if (crc_errors != 0U)
+  {
+    fprintf(stderr, "ddr_tlm: %lu frames, %lu CRC errors\n", frame_nb,
+            crc_errors);
+  }
+
+  return crc_errors != 0U;
+}
@@ -24,9 +24,32 @@
 
 /* Includes ------------------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
+/* DDR traffic generated by the tests, in bytes */
+typedef struct {
+  unsigned long written;
+  unsigned long read;
+} ddr_test_stats;
+
 /* Exported constants --------------------------------------------------------*/
+/* Test result when mismatches were accumulated in continue-on-error mode */
+#define DDR_TEST_ERRORS_ACCUMULATED  0xFE
+
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
+void DDR_Test_Stats_Reset(void);
+void DDR_Test_Stats_Get(ddr_test_stats *stats);
+void DDR_Test_Set_Continue(bool enable);
+bool DDR_Test_Get_Continue(void);
+bool DDR_Test_Set_Cache(bool enable);
+bool DDR_Test_Get_Cache(void);
+void DDR_Test_Cache_Flush(void);
+void DDR_Test_Set_Seed(unsigned long seed);
+unsigned long DDR_Test_Get_Seed(void);
+void DDR_Test_Set_Reserved(unsigned long addr, unsigned long size);
+void DDR_Test_Smp_Seed(bool start);
+void DDR_Test_Errors_Reset(void);
+unsigned long DDR_Test_Errors_Report(void);
+
 uint32_t DDR_Test_Databus(unsigned long addr_in);
 uint32_t DDR_Test_DatabusWalk0(unsigned long loop, unsigned long addr);
 uint32_t DDR_Test_DatabusWalk1(unsigned long loop, unsigned long addr);
@@ -53,6 +76,22 @@ uint32_t DDR_Test_WalkingZeroes(unsigned long size, unsigned long loop_in,
                                 unsigned long addr_in);
 uint32_t DDR_Test_WalkingOnes(unsigned long size, unsigned long loop_in,
                               unsigned long addr_in);
+uint32_t DDR_Test_CacheLine(unsigned long size, unsigned long loop_in,
+                            unsigned long addr_in);
+uint32_t DDR_Test_MarchCMinus(unsigned long size, unsigned long loop_in,
+                              unsigned long addr_in);
+uint32_t DDR_Test_MarchSS(unsigned long size, unsigned long loop_in,
+                          unsigned long addr_in);
+uint32_t DDR_Test_MatsPlus(unsigned long size, unsigned long loop_in,
+                           unsigned long addr_in);
+uint32_t DDR_Test_PerBank(unsigned long rows, unsigned long loop_in,
+                          unsigned long addr_in);
+uint32_t DDR_Test_PerRow(unsigned long rows, unsigned long loop_in,
+                         unsigned long addr_in);
+uint32_t DDR_Test_RowConflict(unsigned long rows, unsigned long loop_in,
+                              unsigned long addr_in);
+uint32_t DDR_Test_Stream(unsigned long size, unsigned long loop_in,
+                         unsigned long addr_in);
 #ifdef TEST_INFINITE_ENABLE
 uint32_t DDR_Test_Infinite_write(unsigned long pattern_in,
                                  unsigned long addr_in);
@@ -0,0 +1,42 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_dma.h
+  * @author  MCD Application Team
+  * @brief   Header for ddr_tool_dma.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DDR_TOOL_DMA_H
+#define __DDR_TOOL_DMA_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+  DDR_DMA_OFF = 0,
+  DDR_DMA_COPY,
+  DDR_DMA_FILL,
+} ddr_dma_mode;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+bool DDR_Dma_Start(ddr_dma_mode mode, unsigned long size, unsigned long addr);
+bool DDR_Dma_Stop(void);
+void DDR_Dma_Status(void);
+bool DDR_Dma_Bench(unsigned long size, unsigned long addr);
+
+#endif /* __DDR_TOOL_DMA_H */
@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_trace.h
+  * @author  MCD Application Team
+  * @brief   Header for ddr_tool_trace.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DDR_TOOL_TRACE_H
+#define __DDR_TOOL_TRACE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/*
+ * Events of the tool, after the HAL_DDR_TraceEventTypeDef events of
+ * HAL_DDR_Init() (1 to 0xFF), with their arguments arg0 / arg1:
+ * BOOT        -              / -
+ * TEST_START  test number    / 1 when split on both cores
+ * TEST_END    test number    / test result
+ * TEST_ERROR  byte lane mask / address, 1st mismatch of the core in a test
+ */
+typedef enum {
+  DDR_TRACE_BOOT = 0x100,
+  DDR_TRACE_TEST_START,
+  DDR_TRACE_TEST_END,
+  DDR_TRACE_TEST_ERROR,
+} ddr_trace_event;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void DDR_Trace_Init(void);
+void DDR_Trace(uint16_t event, uint32_t arg0, uint64_t arg1);
+void DDR_Trace_Dump(void);
+void DDR_Trace_Clear(void);
+void DDR_Trace_Profile(void);
+void DDR_Trace_Training_Dump(void);
+void DDR_Trace_Training_Clear(void);
+
+#endif /* __DDR_TOOL_TRACE_H */
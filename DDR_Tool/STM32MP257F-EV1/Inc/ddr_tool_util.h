@@ -21,6 +21,8 @@
 #define __DDR_TOOL_UTIL_H
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 /* Exported types ------------------------------------------------------------*/
@@ -31,6 +33,11 @@ void UART_Config(void);
 uint32_t Serial_Scanf(uint32_t value);
 void Serial_Putchar(char value);
 void Serial_Printf(char *value, int len);
+void UART_Tx_Poll(void);
+void UART_Tx_Flush(void);
+void UART_Tx_Info(void);
+void UART_Baudrate_Info(void);
+bool UART_Set_Baudrate(uint32_t baudrate);
 void Error_Handler(void);
 void valid_delay_us(unsigned long delay_us);
 
@@ -38,6 +38,14 @@
 #define UTIL_UART_STOPBITS      UART_STOPBITS_1
 #define UTIL_UART_PARITY        UART_PARITY_NONE
 #define UTIL_UART_HWFLOWCTL     UART_HWCONTROL_NONE
+/* HPDMA request of the console output, TX FIFO filled by the CPU if undefined */
+#define UTIL_UART_TX_DMA_REQUEST  HPDMA_REQUEST_USART2_TX
+
+/* Event trace in RETRAM, kept across a warm reset; in SYSRAM if undefined */
+#define UTIL_TRACE_RETRAM
+
+/* Skip the DDR training when valid results are saved in RETRAM */
+/* #define UTIL_DDR_RESTORE_TRAINING */
 
 /* PMIC related configuration */
 #define UTIL_USE_PMIC                     1
@@ -0,0 +1,289 @@
+/**
+  ******************************************************************************
+  * @file    ddr_addrmap.c
+  * @author  MCD Application Team
+  * @brief   Decoder/encoder between the AXI address and the location in the
+  *          DDR devices (rank, bank group, bank, row, column), built from the
+  *          address map programmed in DDRC->ADDRMAP0..11.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_device_hal.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "ddr_addrmap.h"
+#include "stm32mp_util_ddr_conf.h"
+
+/* Private typedef -----------------------------------------------------------*/
+enum {
+  ADDRMAP_RANK = 0,
+  ADDRMAP_BG,
+  ADDRMAP_BANK,
+  ADDRMAP_ROW,
+  ADDRMAP_COL,
+  ADDRMAP_FIELD_NB,
+};
+
+/* HIF address bit of each bit of a field, from bit 0 */
+typedef struct {
+  uint8_t nb;
+  bool end;
+  uint8_t hif[18];
+} addrmap_field;
+
+/* Private define ------------------------------------------------------------*/
+/* ADDRMAP5.ADDRMAP_ROW_B2_10 value selecting ADDRMAP9..11 for row bits 2..10 */
+#define ADDRMAP_ROW_B2_10_OFF   0xFU
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static addrmap_field addrmap[ADDRMAP_FIELD_NB];
+/* log2 of the bytes of one HIF address: the DDR data bus width */
+static unsigned int addrmap_shift;
+
+static const char * const addrmap_name[ADDRMAP_FIELD_NB] = {
+  [ADDRMAP_RANK] = "rank",
+  [ADDRMAP_BG] = "bg",
+  [ADDRMAP_BANK] = "bank",
+  [ADDRMAP_ROW] = "row",
+  [ADDRMAP_COL] = "col",
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/*
+ * Add the next bit of a field, mapped on the HIF bit 'base' + register
+ * value: the all-ones value disables the bit and the upper bits of the field.
+ */
+static void addrmap_add(int id, uint32_t reg, unsigned int pos, uint32_t mask,
+                        unsigned int base)
+{
+  addrmap_field *field = &addrmap[id];
+  uint32_t value = (reg >> pos) & mask;
+
+  if (field->end || (value == mask))
+  {
+    field->end = true;
+    return;
+  }
+
+  field->hif[field->nb++] = (uint8_t)(base + value);
+}
+
+static unsigned long addrmap_get(const addrmap_field *field, unsigned long hif)
+{
+  unsigned long value = 0;
+  unsigned int i;
+
+  for (i = 0; i < field->nb; i++)
+  {
+    value |= ((hif >> field->hif[i]) & 1UL) << i;
+  }
+
+  return value;
+}
+
+static unsigned long addrmap_set(const addrmap_field *field,
+                                 unsigned long value)
+{
+  unsigned long hif = 0;
+  unsigned int i;
+
+  for (i = 0; i < field->nb; i++)
+  {
+    hif |= ((value >> i) & 1UL) << field->hif[i];
+  }
+
+  return hif;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+* @brief Read the address map from the DDRC registers, to be called when the
+*   ADDRMAPx or MSTR registers are modified.
+* @retval None
+*/
+void DDR_AddrMap_Update(void)
+{
+  uint32_t map1 = READ_REG(DDRC->ADDRMAP1);
+  uint32_t map5 = READ_REG(DDRC->ADDRMAP5);
+  uint32_t row_b2_10;
+  unsigned int i;
+
+  memset(addrmap, 0, sizeof(addrmap));
+
+  addrmap_add(ADDRMAP_RANK, READ_REG(DDRC->ADDRMAP0), 0, 0x1F, 6);
+
+  addrmap_add(ADDRMAP_BANK, map1, 0, 0x3F, 2);
+  addrmap_add(ADDRMAP_BANK, map1, 8, 0x3F, 3);
+  addrmap_add(ADDRMAP_BANK, map1, 16, 0x3F, 4);
+
+  addrmap_add(ADDRMAP_BG, READ_REG(DDRC->ADDRMAP8), 0, 0x3F, 2);
+  addrmap_add(ADDRMAP_BG, READ_REG(DDRC->ADDRMAP8), 8, 0x3F, 3);
+
+  /* column bits 0 and 1 are always HIF bits 0 and 1 */
+  addrmap_add(ADDRMAP_COL, 0, 0, 0xF, 0);
+  addrmap_add(ADDRMAP_COL, 0, 0, 0xF, 1);
+  addrmap_add(ADDRMAP_COL, READ_REG(DDRC->ADDRMAP2), 0, 0xF, 2);
+  addrmap_add(ADDRMAP_COL, READ_REG(DDRC->ADDRMAP2), 8, 0x1F, 3);
+  addrmap_add(ADDRMAP_COL, READ_REG(DDRC->ADDRMAP2), 16, 0xF, 4);
+  addrmap_add(ADDRMAP_COL, READ_REG(DDRC->ADDRMAP2), 24, 0xF, 5);
+  for (i = 0; i < 4; i++)
+  {
+    addrmap_add(ADDRMAP_COL, READ_REG(DDRC->ADDRMAP3), i * 8, 0x1F, 6 + i);
+  }
+  addrmap_add(ADDRMAP_COL, READ_REG(DDRC->ADDRMAP4), 0, 0x1F, 10);
+  addrmap_add(ADDRMAP_COL, READ_REG(DDRC->ADDRMAP4), 8, 0x1F, 11);
+
+  addrmap_add(ADDRMAP_ROW, map5, 0, 0xF, 6);
+  addrmap_add(ADDRMAP_ROW, map5, 8, 0xF, 7);
+  row_b2_10 = (map5 >> 16) & 0xFU;
+  for (i = 2; i <= 10; i++)
+  {
+    if (row_b2_10 != ADDRMAP_ROW_B2_10_OFF)
+    {
+      addrmap_add(ADDRMAP_ROW, row_b2_10, 0, 0xF, 6 + i);
+    }
+    else if (i <= 5)
+    {
+      addrmap_add(ADDRMAP_ROW, READ_REG(DDRC->ADDRMAP9), (i - 2) * 8, 0xF,
+                  6 + i);
+    }
+    else if (i <= 9)
+    {
+      addrmap_add(ADDRMAP_ROW, READ_REG(DDRC->ADDRMAP10), (i - 6) * 8, 0xF,
+                  6 + i);
+    }
+    else
+    {
+      addrmap_add(ADDRMAP_ROW, READ_REG(DDRC->ADDRMAP11), 0, 0xF, 6 + i);
+    }
+  }
+  addrmap_add(ADDRMAP_ROW, map5, 24, 0xF, 17);
+  for (i = 0; i < 4; i++)
+  {
+    addrmap_add(ADDRMAP_ROW, READ_REG(DDRC->ADDRMAP6), i * 8, 0xF, 18 + i);
+  }
+  addrmap_add(ADDRMAP_ROW, READ_REG(DDRC->ADDRMAP7), 0, 0xF, 22);
+  addrmap_add(ADDRMAP_ROW, READ_REG(DDRC->ADDRMAP7), 8, 0xF, 23);
+
+  switch (READ_REG(DDRC->MSTR) & DDRC_MSTR_DATA_BUS_WIDTH_Msk)
+  {
+    case DDRC_MSTR_DATA_BUS_WIDTH_0:
+      addrmap_shift = 1;
+      break;
+    case DDRC_MSTR_DATA_BUS_WIDTH_1:
+      addrmap_shift = 0;
+      break;
+    default:
+      addrmap_shift = 2;
+      break;
+  }
+}
+
+/**
+* @brief Get the number of ranks, bank groups, banks, rows and columns.
+* @param size: number of values of each field
+* @retval None
+*/
+void DDR_AddrMap_Get_Size(ddr_addrmap_loc *size)
+{
+  size->rank = 1UL << addrmap[ADDRMAP_RANK].nb;
+  size->bg = 1UL << addrmap[ADDRMAP_BG].nb;
+  size->bank = 1UL << addrmap[ADDRMAP_BANK].nb;
+  size->row = 1UL << addrmap[ADDRMAP_ROW].nb;
+  size->col = 1UL << addrmap[ADDRMAP_COL].nb;
+}
+
+/**
+* @brief Get the bytes of one column, on the whole DDR data bus.
+* @retval Number of bytes
+*/
+unsigned long DDR_AddrMap_Get_Unit(void)
+{
+  return 1UL << addrmap_shift;
+}
+
+/**
+* @brief Decode an AXI address.
+* @param addr: AXI address
+* @param loc: location of the address in the DDR devices
+* @retval false when the address is out of the DDR
+*/
+bool DDR_AddrMap_Decode(unsigned long addr, ddr_addrmap_loc *loc)
+{
+  unsigned long hif;
+
+  if ((addr < (unsigned long)DDR_MEM_BASE) ||
+      (addr - (unsigned long)DDR_MEM_BASE >= (unsigned long)DDR_MEM_SIZE))
+  {
+    return false;
+  }
+
+  hif = (addr - (unsigned long)DDR_MEM_BASE) >> addrmap_shift;
+
+  loc->rank = addrmap_get(&addrmap[ADDRMAP_RANK], hif);
+  loc->bg = addrmap_get(&addrmap[ADDRMAP_BG], hif);
+  loc->bank = addrmap_get(&addrmap[ADDRMAP_BANK], hif);
+  loc->row = addrmap_get(&addrmap[ADDRMAP_ROW], hif);
+  loc->col = addrmap_get(&addrmap[ADDRMAP_COL], hif);
+
+  return true;
+}
+
+/**
+* @brief Encode a location in the DDR devices.
+* @param loc: location, the bits above the size of each field are ignored
+* @retval AXI address
+*/
+unsigned long DDR_AddrMap_Encode(const ddr_addrmap_loc *loc)
+{
+  unsigned long hif;
+
+  hif = addrmap_set(&addrmap[ADDRMAP_RANK], loc->rank) |
+        addrmap_set(&addrmap[ADDRMAP_BG], loc->bg) |
+        addrmap_set(&addrmap[ADDRMAP_BANK], loc->bank) |
+        addrmap_set(&addrmap[ADDRMAP_ROW], loc->row) |
+        addrmap_set(&addrmap[ADDRMAP_COL], loc->col);
+
+  return (unsigned long)DDR_MEM_BASE + (hif << addrmap_shift);
+}
+
+/**
+* @brief Print the AXI address bits of each field, from bit 0.
+* @retval None
+*/
+void DDR_AddrMap_Print(void)
+{
+  unsigned int id;
+  unsigned int i;
+
+  printf("address map (AXI address bits from DDR base, bit 0 first):\n\r");
+  for (id = 0; id < ADDRMAP_FIELD_NB; id++)
+  {
+    printf("  %-4s:", addrmap_name[id]);
+    if (addrmap[id].nb == 0U)
+    {
+      printf(" none");
+    }
+    for (i = 0; i < addrmap[id].nb; i++)
+    {
+      printf(" %u", addrmap[id].hif[i] + addrmap_shift);
+    }
+    printf("\n\r");
+  }
+}
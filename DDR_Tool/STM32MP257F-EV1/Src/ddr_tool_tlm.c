@@ -0,0 +1,370 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_tlm.c
+  * @author  MCD Application Team
+  * @brief   Binary telemetry on the console: the test results, the test
+  *          errors, the register dumps and the timing samples are sent as
+  *          CRC-protected frames, decoded on the host by DDR_Tool/Host
+  *          ddr_tlm.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "ddr_tool_tlm.h"
+
+#ifdef __AARCH64__
+#include "ddr_tool_smp.h"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint8_t buf[DDR_TLM_FRAME_MAX];
+  size_t len;
+} tlm_frame;
+
+/* Private define ------------------------------------------------------------*/
+/* ERROR records sent per core between two DDR_Tlm_Errors_Reset() */
+#define DDR_TLM_ERROR_MAX       64U
+/* registers named since DDR_Tlm_Set_Enable() */
+#define DDR_TLM_REG_MAX         512U
+/* values of one REG record */
+#define DDR_TLM_REG_BATCH       60U
+#define DDR_TLM_CORE_NB         2U
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static bool tlm_enable;
+static unsigned int tlm_errors[DDR_TLM_CORE_NB];
+
+/*
+ * The register names are sent once (REG_NAME), then the values by id: the
+ * dump order is stable, so the next id is checked before the whole table.
+ */
+static struct {
+  const char *section;
+  const char *name;
+} tlm_reg[DDR_TLM_REG_MAX];
+static unsigned int tlm_reg_nb;
+static unsigned int tlm_reg_next;
+
+/* consecutive register values waiting for DDR_Tlm_Flush() */
+static uint32_t tlm_reg_value[DDR_TLM_REG_BATCH];
+static unsigned int tlm_reg_first;
+static unsigned int tlm_reg_pending;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+static void tlm_start(tlm_frame *frame, ddr_tlm_type type)
+{
+  frame->buf[0] = DDR_TLM_SYNC0;
+  frame->buf[1] = DDR_TLM_SYNC1;
+  frame->buf[2] = (uint8_t)type;
+  frame->len = DDR_TLM_HEADER_SIZE;
+}
+
+static void tlm_put(tlm_frame *frame, uint64_t value, unsigned int size)
+{
+  unsigned int i;
+
+  if (frame->len + size > DDR_TLM_HEADER_SIZE + DDR_TLM_PAYLOAD_MAX)
+  {
+    return;
+  }
+
+  for (i = 0; i < size; i++)
+  {
+    frame->buf[frame->len++] = (uint8_t)(value >> (i * 8));
+  }
+}
+
+/* the terminating '\0' is added by the next string, if any */
+static void tlm_put_str(tlm_frame *frame, const char *str, bool last)
+{
+  size_t len = strlen(str) + (last ? 0U : 1U);
+
+  if (frame->len + len > DDR_TLM_HEADER_SIZE + DDR_TLM_PAYLOAD_MAX)
+  {
+    len = DDR_TLM_HEADER_SIZE + DDR_TLM_PAYLOAD_MAX - frame->len;
+  }
+
+  memcpy(&frame->buf[frame->len], str, len);
+  frame->len += len;
+}
+
+static void tlm_send(tlm_frame *frame)
+{
+  size_t payload = frame->len - DDR_TLM_HEADER_SIZE;
+  uint16_t crc;
+
+  frame->buf[3] = (uint8_t)payload;
+  frame->buf[4] = (uint8_t)(payload >> 8);
+  crc = DDR_Tlm_Crc(&frame->buf[2], frame->len - 2U);
+  frame->buf[frame->len++] = (uint8_t)crc;
+  frame->buf[frame->len++] = (uint8_t)(crc >> 8);
+
+#ifdef __AARCH64__
+  DDR_Smp_Write(frame->buf, frame->len);
+#else
+  (void)fwrite(frame->buf, 1, frame->len, stdout);
+  (void)fflush(stdout);
+#endif
+}
+
+static unsigned int tlm_reg_id(const char *base, const char *section,
+                               const char *name)
+{
+  tlm_frame frame;
+  unsigned int id;
+
+  if ((tlm_reg_next < tlm_reg_nb) &&
+      (tlm_reg[tlm_reg_next].name == name) &&
+      (tlm_reg[tlm_reg_next].section == section))
+  {
+    return tlm_reg_next++;
+  }
+
+  for (id = 0; id < tlm_reg_nb; id++)
+  {
+    if ((tlm_reg[id].name == name) && (tlm_reg[id].section == section))
+    {
+      tlm_reg_next = id + 1U;
+      return id;
+    }
+  }
+
+  if (tlm_reg_nb == DDR_TLM_REG_MAX)
+  {
+    return DDR_TLM_REG_MAX;
+  }
+
+  id = tlm_reg_nb++;
+  tlm_reg[id].section = section;
+  tlm_reg[id].name = name;
+  tlm_reg_next = id + 1U;
+
+  tlm_start(&frame, DDR_TLM_REG_NAME);
+  tlm_put(&frame, id, 2);
+  tlm_put_str(&frame, base, false);
+  tlm_put_str(&frame, section, false);
+  tlm_put_str(&frame, name, true);
+  tlm_send(&frame);
+
+  return id;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+* @brief Select the output of the results: text or telemetry frames. The
+*   register names are sent again after each enable.
+* @param enable: true for the telemetry frames
+* @retval None
+*/
+void DDR_Tlm_Set_Enable(bool enable)
+{
+  DDR_Tlm_Flush();
+  tlm_reg_nb = 0;
+  tlm_reg_next = 0;
+  tlm_enable = enable;
+}
+
+/**
+* @brief Get the output of the results.
+* @retval true for the telemetry frames
+*/
+bool DDR_Tlm_Get_Enable(void)
+{
+  return tlm_enable;
+}
+
+/**
+* @brief CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF).
+* @param data: bytes
+* @param len: number of bytes
+* @retval CRC
+*/
+uint16_t DDR_Tlm_Crc(const uint8_t *data, size_t len)
+{
+  uint16_t crc = 0xFFFFU;
+  size_t i;
+  int bit;
+
+  for (i = 0; i < len; i++)
+  {
+    crc ^= (uint16_t)((uint16_t)data[i] << 8);
+    for (bit = 0; bit < 8; bit++)
+    {
+      crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) :
+                              (uint16_t)(crc << 1);
+    }
+  }
+
+  return crc;
+}
+
+/**
+* @brief Send the result of a test, same content as the PERF line.
+* @param id: test number
+* @param flags: DDR_TLM_FLAG_SMP, DDR_TLM_FLAG_WB
+* @param result: test result, 0 when passed
+* @param speed: DDR speed in kHz
+* @param written: bytes written
+* @param read: bytes read
+* @param elapsed_us: duration of the test
+* @param test_name: name of the test
+* @param ddr_name: name of the DDR
+* @retval None
+*/
+void DDR_Tlm_Result(int id, uint8_t flags, uint32_t result, uint32_t speed,
+                    unsigned long written, unsigned long read,
+                    unsigned long elapsed_us, const char *test_name,
+                    const char *ddr_name)
+{
+  tlm_frame frame;
+
+  tlm_start(&frame, DDR_TLM_RESULT);
+  tlm_put(&frame, (uint64_t)id, 1);
+  tlm_put(&frame, flags, 1);
+  tlm_put(&frame, result, 4);
+  tlm_put(&frame, speed, 4);
+  tlm_put(&frame, written, 8);
+  tlm_put(&frame, read, 8);
+  tlm_put(&frame, elapsed_us, 8);
+  tlm_put_str(&frame, test_name, false);
+  tlm_put_str(&frame, ddr_name, true);
+  tlm_send(&frame);
+}
+
+/**
+* @brief Restart the count of the ERROR records, at the start of a test.
+* @retval None
+*/
+void DDR_Tlm_Errors_Reset(void)
+{
+  memset(tlm_errors, 0, sizeof(tlm_errors));
+}
+
+/**
+* @brief Send a failing word, the first DDR_TLM_ERROR_MAX of each core only:
+*   the other errors are in the summary sample "ERRORS".
+* @param core: core index
+* @param addr: address of the word
+* @param expected: expected value
+* @param actual: value read
+* @retval None
+*/
+void DDR_Tlm_Error(unsigned int core, unsigned long addr,
+                   unsigned long expected, unsigned long actual)
+{
+  tlm_frame frame;
+
+  if ((core >= DDR_TLM_CORE_NB) || (tlm_errors[core] >= DDR_TLM_ERROR_MAX))
+  {
+    return;
+  }
+  tlm_errors[core]++;
+
+  tlm_start(&frame, DDR_TLM_ERROR);
+  tlm_put(&frame, core, 1);
+  tlm_put(&frame, addr, 8);
+  tlm_put(&frame, expected, 8);
+  tlm_put(&frame, actual, 8);
+  tlm_send(&frame);
+}
+
+/**
+* @brief Send a timing sample or a summary, decoded as a line
+*   "<tag>;<label>;<value>;...".
+* @param tag: type of sample, as "STREAM" or "LAT"
+* @param label: name of the sample, may be empty
+* @param value: values
+* @param nb: number of values
+* @retval None
+*/
+void DDR_Tlm_Sample(const char *tag, const char *label,
+                    const unsigned long *value, unsigned int nb)
+{
+  tlm_frame frame;
+  unsigned int i;
+
+  tlm_start(&frame, DDR_TLM_SAMPLE);
+  tlm_put_str(&frame, tag, false);
+  tlm_put_str(&frame, label, false);
+  for (i = 0; i < nb; i++)
+  {
+    tlm_put(&frame, value[i], 8);
+  }
+  tlm_send(&frame);
+}
+
+/**
+* @brief Output of HAL_DDR_Dump_Reg(): the consecutive values are grouped in
+*   one record, sent by DDR_Tlm_Flush() at the end of the dump.
+* @param base: register base
+* @param section: register section
+* @param name: register name
+* @param value: register value
+* @retval None
+*/
+void DDR_Tlm_Reg(const char *base, const char *section, const char *name,
+                 uint32_t value)
+{
+  unsigned int id;
+
+  /* the REG_NAME record is sent before the pending values */
+  id = tlm_reg_id(base, section, name);
+  if (id == DDR_TLM_REG_MAX)
+  {
+    return;
+  }
+
+  if ((tlm_reg_pending != 0U) &&
+      ((id != tlm_reg_first + tlm_reg_pending) ||
+       (tlm_reg_pending == DDR_TLM_REG_BATCH)))
+  {
+    DDR_Tlm_Flush();
+  }
+
+  if (tlm_reg_pending == 0U)
+  {
+    tlm_reg_first = id;
+  }
+  tlm_reg_value[tlm_reg_pending++] = value;
+}
+
+/**
+* @brief Send the pending register values.
+* @retval None
+*/
+void DDR_Tlm_Flush(void)
+{
+  tlm_frame frame;
+  unsigned int i;
+
+  if (tlm_reg_pending == 0U)
+  {
+    return;
+  }
+
+  tlm_start(&frame, DDR_TLM_REG);
+  tlm_put(&frame, tlm_reg_first, 2);
+  for (i = 0; i < tlm_reg_pending; i++)
+  {
+    tlm_put(&frame, tlm_reg_value[i], 4);
+  }
+  tlm_send(&frame);
+
+  tlm_reg_pending = 0;
+}
@@ -0,0 +1,691 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_trace.c
+  * @author  MCD Application Team
+  * @brief   Binary event trace: the steps of HAL_DDR_Init() and of the tests
+  *          are recorded with their generic timer count in one ring per core,
+  *          without formatting, and decoded by the "trace" command. With
+  *          UTIL_TRACE_RETRAM, the rings are kept across a warm reset.
+  *          The steps of the last HAL_DDR_Init() are also kept in a profile,
+  *          reported by the "info" command, and the messages of the PHY
+  *          training firmware in a log, decoded by "training log".
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_device_hal.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "ddr_tool_trace.h"
+#include "system_time.h"
+#include "stm32mp_util_conf.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint64_t ts;          /* generic timer count */
+  uint16_t event;       /* HAL_DDR_TraceEventTypeDef or ddr_trace_event */
+  uint16_t boot;        /* boot number, to order the events of several boots */
+  uint32_t arg0;
+  uint64_t arg1;
+} ddr_trace_entry;
+
+#define DDR_TRACE_CORE_NB       2U
+#define DDR_TRACE_ENTRY_NB      256U
+
+typedef struct {
+  uint64_t ts;
+  uint16_t event;
+  uint32_t arg;
+} ddr_profile_entry;
+
+/* HAL_DDR_Init() steps: 20, and 3 per trained P-state */
+#define DDR_PROFILE_ENTRY_NB    48U
+
+/*
+ * Training firmware messages, as 32-bit words: each training starts with a
+ * START word (boot number, P-state), followed by MAJOR words (message code)
+ * and by STREAM words (number of stored arguments), each one followed by the
+ * string index and the arguments of the streaming message.
+ */
+#define DDR_TRAINING_WORD_NB    1024U
+#define DDR_TRAINING_RUN_NB     16U
+
+typedef struct {
+  uint32_t head;                        /* words written since the clear */
+  uint32_t run_nb;                      /* trainings started since the clear */
+  uint32_t run[DDR_TRAINING_RUN_NB];    /* head at the start of each training */
+  uint32_t word[DDR_TRAINING_WORD_NB];
+} ddr_training_log;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t boot;
+  uint32_t head[DDR_TRACE_CORE_NB];   /* entries written since the clear */
+  ddr_trace_entry entry[DDR_TRACE_CORE_NB][DDR_TRACE_ENTRY_NB];
+  ddr_training_log training;
+} ddr_trace_area;
+
+/* Private define ------------------------------------------------------------*/
+/* the magic number changes with the layout, to clear an incompatible area */
+#define DDR_TRACE_MAGIC         (0x54540000U ^ (uint32_t)sizeof(ddr_trace_area))
+
+#define DDR_TRAINING_START      0x1U
+#define DDR_TRAINING_MAJOR      0x2U
+#define DDR_TRAINING_STREAM     0x3U
+
+/*
+ * Start of RETRAM, within its first 20KB: the PHY retention register area of
+ * the HAL is at its end (about 2.3KB, see HAL_DDR_SetRetentionAreaBase).
+ */
+#define DDR_TRACE_AREA_MAX      (20U * 1024U)
+
+_Static_assert(sizeof(ddr_trace_area) <= DDR_TRACE_AREA_MAX,
+               "ddr_trace_area exceeds DDR_TRACE_AREA_MAX");
+
+/* Private macro -------------------------------------------------------------*/
+#define DDR_TRAINING_WORD(kind, value) (((uint32_t)(kind) << 28) | (value))
+#define DDR_TRAINING_KIND(word)        ((word) >> 28)
+#ifdef UTIL_TRACE_RETRAM
+#define DDR_TRACE_AREA          ((ddr_trace_area *)RETRAM_BASE)
+#else
+#define DDR_TRACE_AREA          (&trace_sysram)
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+#ifndef UTIL_TRACE_RETRAM
+static ddr_trace_area trace_sysram;
+#endif
+
+/* NULL until DDR_Trace_Init(): the events are ignored */
+static ddr_trace_area *trace;
+
+/* steps of the last HAL_DDR_Init(), recorded even when the trace is stopped */
+static ddr_profile_entry profile[DDR_PROFILE_ENTRY_NB];
+static unsigned int profile_nb;
+static bool profile_end;
+
+/* index of the HAL_DDR_TRACE_SET_REG argument */
+static const char * const reg_group_name[] = {
+  "static", "timing", "perf", "map",
+  "basic", "advanced", "mode_register", "swizzle",
+};
+
+/*
+ * Text of the major messages of the training firmware (Training Firmware App
+ * Note). The streaming messages are printed as their string index and
+ * arguments, their text is in the .strings file delivered with the firmware.
+ */
+static const struct {
+  uint32_t msg;
+  const char *text;
+} training_msg[] = {
+  {0x00, "end of initialization"},
+  {0x01, "end of fine write leveling"},
+  {0x02, "end of read enable training"},
+  {0x03, "end of read delay center optimization"},
+  {0x04, "end of write delay center optimization"},
+  {0x05, "end of 2D read delay/voltage center optimization"},
+  {0x06, "end of 2D write delay/voltage center optimization"},
+  {0x07, "training has run successfully"},
+  {0x09, "end of max read latency training"},
+  {0x0A, "end of read dq deskew training"},
+  {0x0C, "end of all DB training"},
+  {0x0D, "end of CA training"},
+  {0xFD, "end of MPR read delay center optimization"},
+  {0xFE, "end of write leveling coarse delay"},
+  {0xFF, "training has failed"},
+};
+
+static const struct {
+  uint16_t event;
+  const char *name;
+} trace_name[] = {
+  {HAL_DDR_TRACE_INIT, "DDR init"},
+  {HAL_DDR_TRACE_RESET, "DDR reset"},
+  {HAL_DDR_TRACE_CTL_INIT, "DDRCTRL init"},
+  {HAL_DDR_TRACE_PHY_STAGE, "PHY step"},
+  {HAL_DDR_TRACE_PHY_INIT, "PHY init"},
+  {HAL_DDR_TRACE_READY, "DDR ready"},
+  {HAL_DDR_TRACE_INIT_END, "DDR init end"},
+  {HAL_DDR_TRACE_SYSCONF, "sysconf"},
+  {HAL_DDR_TRACE_SET_REG, "registers"},
+  {HAL_DDR_TRACE_REFRESH, "refresh restore"},
+  {HAL_DDR_TRACE_RESTORE, "PHY registers restore"},
+  {DDR_TRACE_BOOT, "boot"},
+  {DDR_TRACE_TEST_START, "test start"},
+  {DDR_TRACE_TEST_END, "test end"},
+  {DDR_TRACE_TEST_ERROR, "test error"},
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+static const char *reg_group(uint32_t index)
+{
+  if (index >= sizeof(reg_group_name) / sizeof(reg_group_name[0]))
+  {
+    return "?";
+  }
+
+  return reg_group_name[index];
+}
+
+static const char *training_text(uint32_t msg)
+{
+  unsigned int i;
+
+  for (i = 0; i < sizeof(training_msg) / sizeof(training_msg[0]); i++)
+  {
+    if (training_msg[i].msg == msg)
+    {
+      return training_msg[i].text;
+    }
+  }
+
+  return "?";
+}
+
+static void training_put(ddr_training_log *log, uint32_t word)
+{
+  log->word[log->head % DDR_TRAINING_WORD_NB] = word;
+  log->head++;
+}
+
+static uint32_t training_get(const ddr_training_log *log, uint32_t index)
+{
+  return log->word[index % DDR_TRAINING_WORD_NB];
+}
+
+/* print the messages of the training started at word index, until end */
+static void training_print(const ddr_training_log *log, uint32_t index,
+                           uint32_t end)
+{
+  uint32_t word = training_get(log, index++);
+  uint32_t msg;
+  uint32_t nb;
+  uint32_t i;
+
+  printf("boot %u, training of P%u:\n\r", word & 0xFFFFU,
+         (word >> 16) & 0xFFU);
+
+  while (index < end)
+  {
+    word = training_get(log, index++);
+
+    switch (DDR_TRAINING_KIND(word))
+    {
+      case DDR_TRAINING_MAJOR:
+        msg = word & 0xFFFFU;
+        printf("  major 0x%02x %s\n\r", msg, training_text(msg));
+        break;
+      case DDR_TRAINING_STREAM:
+        nb = word & 0xFFU;
+        if ((nb > HAL_DDR_TRAINING_ARG_MAX) || (index + 1U + nb > end))
+        {
+          printf("  invalid word 0x%08x\n\r", word);
+          return;
+        }
+        msg = training_get(log, index++);
+        printf("  stream 0x%08x", msg);
+        for (i = 0; i < nb; i++)
+        {
+          printf(" 0x%x", training_get(log, index++));
+        }
+        printf("%s\n\r", (nb < (msg & 0xFFFFU)) ? " ..." : "");
+        break;
+      default:
+        printf("  invalid word 0x%08x\n\r", word);
+        return;
+    }
+  }
+}
+
+static unsigned int get_core_id(void)
+{
+  uint64_t mpidr;
+
+  __asm volatile("MRS %0, MPIDR_EL1" : "=r" (mpidr));
+
+  return (unsigned int)(mpidr & (DDR_TRACE_CORE_NB - 1));
+}
+
+static void trace_print(unsigned int core, const ddr_trace_entry *entry,
+                        uint64_t delta)
+{
+  const char *name = "?";
+  unsigned int i;
+
+  for (i = 0; i < sizeof(trace_name) / sizeof(trace_name[0]); i++)
+  {
+    if (trace_name[i].event == entry->event)
+    {
+      name = trace_name[i].name;
+      break;
+    }
+  }
+
+  printf("%4u %4u %12lu %10lu  %s", entry->boot, core,
+         (unsigned long)timer_ticks_to_us(entry->ts),
+         (unsigned long)timer_ticks_to_us(delta), name);
+
+  switch (entry->event)
+  {
+    case HAL_DDR_TRACE_CTL_INIT:
+    case HAL_DDR_TRACE_READY:
+    case HAL_DDR_TRACE_SYSCONF:
+    case HAL_DDR_TRACE_REFRESH:
+    case DDR_TRACE_BOOT:
+      printf("\n\r");
+      break;
+    case HAL_DDR_TRACE_SET_REG:
+      printf(" %s\n\r", reg_group(entry->arg0));
+      break;
+    case HAL_DDR_TRACE_INIT:
+    case HAL_DDR_TRACE_RESET:
+    case HAL_DDR_TRACE_RESTORE:
+      printf("%s\n\r", entry->arg0 ? " (standby exit)" : "");
+      break;
+    case HAL_DDR_TRACE_PHY_STAGE:
+      printf(" %c P%u\n\r", (char)(entry->arg0 & 0xFFU), entry->arg0 >> 8);
+      break;
+    case HAL_DDR_TRACE_PHY_INIT:
+    case HAL_DDR_TRACE_INIT_END:
+      printf(" [%d]\n\r", (int)entry->arg0);
+      break;
+    case DDR_TRACE_TEST_START:
+      printf(" %u%s\n\r", entry->arg0, entry->arg1 ? " smp" : "");
+      break;
+    case DDR_TRACE_TEST_END:
+      printf(" %u [%lu]\n\r", entry->arg0, (unsigned long)entry->arg1);
+      break;
+    case DDR_TRACE_TEST_ERROR:
+      printf(" 0x%lx lanes 0x%02x\n\r", (unsigned long)entry->arg1,
+             entry->arg0);
+      break;
+    default:
+      printf(" 0x%x 0x%lx\n\r", entry->arg0, (unsigned long)entry->arg1);
+      break;
+  }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+* @brief Start the trace: the rings of the previous boots are kept when they
+*   are valid (UTIL_TRACE_RETRAM), then a BOOT event is recorded.
+* @retval None
+*/
+void DDR_Trace_Init(void)
+{
+  ddr_trace_area *area = DDR_TRACE_AREA;
+
+#ifdef UTIL_TRACE_RETRAM
+  __HAL_RCC_RETRAM_CLK_ENABLE();
+#endif
+
+  if (area->magic != DDR_TRACE_MAGIC)
+  {
+    memset(area, 0, sizeof(*area));
+    area->magic = DDR_TRACE_MAGIC;
+  }
+  area->boot++;
+
+  trace = area;
+  DDR_Trace(DDR_TRACE_BOOT, 0, 0);
+}
+
+/**
+* @brief Record an event in the ring of the current core, the oldest entry is
+*   overwritten when the ring is full.
+* @param event: HAL_DDR_TraceEventTypeDef or ddr_trace_event
+* @param arg0: 1st argument of the event
+* @param arg1: 2nd argument of the event
+* @retval None
+*/
+void DDR_Trace(uint16_t event, uint32_t arg0, uint64_t arg1)
+{
+  unsigned int core = get_core_id();
+  ddr_trace_entry *entry;
+  uint32_t head;
+
+  if (trace == NULL)
+  {
+    return;
+  }
+
+  head = trace->head[core];
+  entry = &trace->entry[core][head % DDR_TRACE_ENTRY_NB];
+  entry->ts = timer_get_count();
+  entry->event = event;
+  entry->boot = (uint16_t)trace->boot;
+  entry->arg0 = arg0;
+  entry->arg1 = arg1;
+  trace->head[core] = head + 1U;
+}
+
+/**
+* @brief Print the events of both cores in time order: boot number, core,
+*   time and delta with the previous event of the boot in us, event.
+* @retval None
+*/
+void DDR_Trace_Dump(void)
+{
+  uint32_t index[DDR_TRACE_CORE_NB];
+  const ddr_trace_entry *entry;
+  const ddr_trace_entry *next;
+  const ddr_trace_entry *last = NULL;
+  unsigned int core;
+  unsigned int sel;
+
+  if (trace == NULL)
+  {
+    printf("trace not started\n\r");
+    return;
+  }
+
+  for (core = 0; core < DDR_TRACE_CORE_NB; core++)
+  {
+    index[core] = 0;
+    if (trace->head[core] > DDR_TRACE_ENTRY_NB)
+    {
+      index[core] = trace->head[core] - DDR_TRACE_ENTRY_NB;
+      printf("core %u: %u oldest events lost\n\r", core, index[core]);
+    }
+  }
+
+  printf("boot core      time us   delta us  event\n\r");
+
+  do
+  {
+    /* next event: smallest boot number, then smallest count */
+    next = NULL;
+    sel = 0;
+    for (core = 0; core < DDR_TRACE_CORE_NB; core++)
+    {
+      if (index[core] == trace->head[core])
+      {
+        continue;
+      }
+
+      entry = &trace->entry[core][index[core] % DDR_TRACE_ENTRY_NB];
+      if ((next == NULL) || (entry->boot < next->boot) ||
+          ((entry->boot == next->boot) && (entry->ts < next->ts)))
+      {
+        next = entry;
+        sel = core;
+      }
+    }
+
+    if (next != NULL)
+    {
+      trace_print(sel, next, ((last != NULL) && (last->boot == next->boot)) ?
+                             next->ts - last->ts : 0U);
+      last = next;
+      index[sel]++;
+    }
+  } while (next != NULL);
+}
+
+/**
+* @brief Remove the recorded events, the boot number is kept.
+* @retval None
+*/
+void DDR_Trace_Clear(void)
+{
+  unsigned int core;
+
+  if (trace == NULL)
+  {
+    return;
+  }
+
+  for (core = 0; core < DDR_TRACE_CORE_NB; core++)
+  {
+    trace->head[core] = 0;
+  }
+}
+
+/**
+* @brief Print the duration of each step of the last HAL_DDR_Init(): the step
+*   starts at its event and ends at the next one.
+* @retval None
+*/
+void DDR_Trace_Profile(void)
+{
+  const ddr_profile_entry *entry;
+  unsigned int step;
+  unsigned int i;
+  char name[32];
+
+  if (profile_nb == 0U)
+  {
+    return;
+  }
+
+  printf("DDR init profile (us)%s:\n\r", profile_end ? "" : ", in progress");
+
+  for (i = 0; i + 1U < profile_nb; i++)
+  {
+    entry = &profile[i];
+    step = entry->arg & 0xFFU;
+
+    switch (entry->event)
+    {
+      case HAL_DDR_TRACE_INIT:
+        snprintf(name, sizeof(name), "MSP init");
+        break;
+      case HAL_DDR_TRACE_RESET:
+        snprintf(name, sizeof(name), "%s",
+                 entry->arg ? "standby exit clocks" : "DDR reset");
+        break;
+      case HAL_DDR_TRACE_SYSCONF:
+        snprintf(name, sizeof(name), "sysconf");
+        break;
+      case HAL_DDR_TRACE_SET_REG:
+        snprintf(name, sizeof(name), "registers %s", reg_group(entry->arg));
+        break;
+      case HAL_DDR_TRACE_CTL_INIT:
+        snprintf(name, sizeof(name), "refresh disable");
+        break;
+      case HAL_DDR_TRACE_PHY_STAGE:
+        snprintf(name, sizeof(name), "PHY %c %s", (char)step,
+                 (step == 'M') ? "message block" :
+                 (step == 'C') ? "configuration" :
+                 (step == 'S') ? "skip training" :
+                 (step == 'D') ? "IMEM load" :
+                 (step == 'F') ? "DMEM load" :
+                 (step == 'G') ? "training" :
+                 (step == 'H') ? "results" :
+                 (step == 'I') ? "PIE image" :
+                 (step == 'R') ? "retention save" : "?");
+        if ((step == 'F') || (step == 'G') || (step == 'H'))
+        {
+          snprintf(name + strlen(name), sizeof(name) - strlen(name), " P%u",
+                   (unsigned int)(entry->arg >> 8));
+        }
+        break;
+      case HAL_DDR_TRACE_PHY_INIT:
+        snprintf(name, sizeof(name), "controller activate");
+        break;
+      case HAL_DDR_TRACE_REFRESH:
+        snprintf(name, sizeof(name), "refresh restore");
+        break;
+      case HAL_DDR_TRACE_RESTORE:
+        snprintf(name, sizeof(name), "PHY registers restore");
+        break;
+      case HAL_DDR_TRACE_READY:
+        snprintf(name, sizeof(name), "DDR tests");
+        break;
+      default:
+        snprintf(name, sizeof(name), "event %u", entry->event);
+        break;
+    }
+
+    printf("  %-24s %10lu\n\r", name,
+           (unsigned long)timer_ticks_to_us(profile[i + 1U].ts - entry->ts));
+  }
+
+  printf("  %-24s %10lu\n\r", "total",
+         (unsigned long)timer_ticks_to_us(profile[profile_nb - 1U].ts -
+                                          profile[0].ts));
+}
+
+/**
+* @brief Print the messages of the PHY training firmware recorded by the last
+*   trainings, with their boot number and P-state.
+* @retval None
+*/
+void DDR_Trace_Training_Dump(void)
+{
+  const ddr_training_log *log;
+  uint32_t first;
+  uint32_t run;
+  uint32_t end;
+
+  if (trace == NULL)
+  {
+    printf("trace not started\n\r");
+    return;
+  }
+
+  log = &trace->training;
+  if (log->run_nb == 0U)
+  {
+    printf("no training recorded\n\r");
+    return;
+  }
+
+  /* oldest training of which the 1st word is still in the log */
+  first = 0;
+  if (log->run_nb > DDR_TRAINING_RUN_NB)
+  {
+    first = log->run_nb - DDR_TRAINING_RUN_NB;
+  }
+  while ((first < log->run_nb) &&
+         (log->head - log->run[first % DDR_TRAINING_RUN_NB] >
+          DDR_TRAINING_WORD_NB))
+  {
+    first++;
+  }
+
+  if (first != 0U)
+  {
+    printf("%u oldest trainings lost\n\r", first);
+  }
+
+  for (run = first; run < log->run_nb; run++)
+  {
+    end = (run + 1U < log->run_nb) ?
+          log->run[(run + 1U) % DDR_TRAINING_RUN_NB] : log->head;
+    training_print(log, log->run[run % DDR_TRAINING_RUN_NB], end);
+  }
+}
+
+/**
+* @brief Remove the recorded training messages.
+* @retval None
+*/
+void DDR_Trace_Training_Clear(void)
+{
+  if (trace == NULL)
+  {
+    return;
+  }
+
+  trace->training.head = 0;
+  trace->training.run_nb = 0;
+}
+
+/**
+* @brief Record a message of the PHY training firmware in the log, without
+*   formatting, replaces the weak HAL function. Called between the mailbox
+*   handshakes, the time spent here delays the training.
+* @param major: true for a major message, false for a streaming message
+* @param msg: major message code or string index of the streaming message
+* @param arg: arguments of the streaming message
+* @param nb: number of arguments in arg
+* @retval None
+*/
+void HAL_DDR_TraceTraining(bool major, uint32_t msg, const uint32_t *arg,
+                           uint32_t nb)
+{
+  ddr_training_log *log;
+  uint32_t i;
+
+  /* messages without training start are not recorded */
+  if ((trace == NULL) || (trace->training.run_nb == 0U))
+  {
+    return;
+  }
+
+  log = &trace->training;
+
+  if (major)
+  {
+    training_put(log, DDR_TRAINING_WORD(DDR_TRAINING_MAJOR, msg & 0xFFFFU));
+    return;
+  }
+
+  training_put(log, DDR_TRAINING_WORD(DDR_TRAINING_STREAM, nb));
+  training_put(log, msg);
+  for (i = 0; i < nb; i++)
+  {
+    training_put(log, arg[i]);
+  }
+}
+
+/**
+* @brief Record the steps of HAL_DDR_Init(), replaces the weak HAL function.
+* @param event: step of the DDR initialization
+* @param arg: argument of the step
+* @retval None
+*/
+void HAL_DDR_Trace(HAL_DDR_TraceEventTypeDef event, uint32_t arg)
+{
+  uint64_t ts = timer_get_count();
+
+  if (event == HAL_DDR_TRACE_INIT)
+  {
+    profile_nb = 0;
+    profile_end = false;
+  }
+
+  if (profile_nb < DDR_PROFILE_ENTRY_NB)
+  {
+    profile[profile_nb].ts = ts;
+    profile[profile_nb].event = (uint16_t)event;
+    profile[profile_nb].arg = arg;
+    profile_nb++;
+  }
+
+  if (event == HAL_DDR_TRACE_INIT_END)
+  {
+    profile_end = true;
+  }
+
+  /* the next training firmware messages are those of this P-state */
+  if ((event == HAL_DDR_TRACE_PHY_STAGE) && ((arg & 0xFFU) == 'G') &&
+      (trace != NULL))
+  {
+    ddr_training_log *log = &trace->training;
+
+    log->run[log->run_nb % DDR_TRAINING_RUN_NB] = log->head;
+    log->run_nb++;
+    training_put(log, DDR_TRAINING_WORD(DDR_TRAINING_START,
+                                        ((arg >> 8) << 16) |
+                                        (trace->boot & 0xFFFFU)));
+  }
+
+  DDR_Trace((uint16_t)event, arg, 0);
+}
@@ -21,28 +21,198 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32mp2xx_hal.h"
 
+#include <limits.h>
+#include <stdbool.h>
+
 #include "stm32mp257f_eval.h"
 
 #include "ddr_tool_util.h"
 #include "main.h"
+#include "system_time.h"
 #include "stm32mp_util_conf.h"
 #include "stm32mp_util_ddr_conf.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
 #define HAL_TIMEOUT_VALUE   HAL_MAX_DELAY
+/* console output ring, power of 2 */
+#define UART_TX_RING_SIZE   8192UL
+#define UART_TX_RING_MASK   (UART_TX_RING_SIZE - 1UL)
+#define UART_TX_DMA_CHANNEL HPDMA1_Channel14
+/* USARTDIV range (BRR) and baud rate error accepted, in per mille */
+#define UART_DIV_MIN        0x10UL
+#define UART_DIV_MAX        0xFFFFUL
+#define UART_BAUD_ERROR_MAX 20UL
+/* time given to the terminal to follow a baud rate change */
+#define UART_BAUD_TIMEOUT_S 10UL
 
 /* Private macro -------------------------------------------------------------*/
+#define uart_tx_dmb()       __asm volatile("DMB SY" : : : "memory")
+
 /* Private variables ---------------------------------------------------------*/
 /* UART handler declaration, used for logging */
 UART_HandleTypeDef huart;
 
+/*
+ * Console output ring: printf and Serial_Putchar/Serial_Printf only copy the
+ * characters, the HPDMA (or the TX FIFO without DMA) sends them. No interrupt
+ * is used at EL3: the A35_0 core restarts the transfer on the next output, on
+ * UART_Tx_Poll() and on UART_Tx_Flush(). The output of both cores is
+ * serialized by DDR_Smp_Printf(): one writer and one reader at a time.
+ * The memory is mapped non-cacheable, the HPDMA reads the ring directly.
+ */
+static char uart_tx_ring[UART_TX_RING_SIZE];
+static volatile unsigned long uart_tx_head;     /* characters written */
+static volatile unsigned long uart_tx_tail;     /* characters sent */
+static unsigned long uart_tx_dma_len;           /* characters in the DMA */
+static volatile unsigned long uart_tx_overflow; /* writes on a full ring */
+static DMA_HandleTypeDef uart_tx_dma;
+static bool uart_tx_dma_ready;
+static bool uart_tx_ready;
+
 /* Private function prototypes -----------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
 /* Exported macro ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 
+static bool uart_tx_is_core0(void)
+{
+  uint64_t mpidr;
+
+  __asm volatile("MRS %0, MPIDR_EL1" : "=r" (mpidr));
+
+  return (mpidr & 0xFFU) == 0U;
+}
+
+/* Without DMA request, the TX FIFO is filled by uart_tx_kick() */
+static void uart_tx_dma_setup(void)
+{
+#ifdef UTIL_UART_TX_DMA_REQUEST
+  __HAL_RCC_HPDMA1_CLK_ENABLE();
+
+  uart_tx_dma.Instance = UART_TX_DMA_CHANNEL;
+  uart_tx_dma.Init.Request = UTIL_UART_TX_DMA_REQUEST;
+  uart_tx_dma.Init.BlkHWRequest = DMA_BREQ_SINGLE_BURST;
+  uart_tx_dma.Init.Direction = DMA_MEMORY_TO_PERIPH;
+  uart_tx_dma.Init.SrcInc = DMA_SINC_INCREMENTED;
+  uart_tx_dma.Init.DestInc = DMA_DINC_FIXED;
+  uart_tx_dma.Init.SrcDataWidth = DMA_SRC_DATAWIDTH_BYTE;
+  uart_tx_dma.Init.DestDataWidth = DMA_DEST_DATAWIDTH_BYTE;
+  uart_tx_dma.Init.Priority = DMA_LOW_PRIORITY_LOW_WEIGHT;
+  uart_tx_dma.Init.SrcBurstLength = 1;
+  uart_tx_dma.Init.DestBurstLength = 1;
+  uart_tx_dma.Init.TransferAllocatedPort = DMA_SRC_ALLOCATED_PORT0 |
+                                           DMA_DEST_ALLOCATED_PORT1;
+  uart_tx_dma.Init.TransferEventMode = DMA_TCEM_BLOCK_TRANSFER;
+  uart_tx_dma.Init.Mode = DMA_NORMAL;
+
+  if (HAL_DMA_Init(&uart_tx_dma) != HAL_OK)
+  {
+    return;
+  }
+
+#if defined CORTEX_IN_SECURE_STATE
+  if (HAL_DMA_ConfigChannelAttributes(&uart_tx_dma,
+                                      DMA_CHANNEL_PRIV | DMA_CHANNEL_SEC |
+                                      DMA_CHANNEL_SRC_SEC |
+                                      DMA_CHANNEL_DEST_SEC) != HAL_OK)
+  {
+    return;
+  }
+#endif /* CORTEX_IN_SECURE_STATE */
+
+  SET_BIT(hcom_uart[COM1].Instance->CR3, USART_CR3_DMAT);
+  uart_tx_dma_ready = true;
+#endif /* UTIL_UART_TX_DMA_REQUEST */
+}
+
+/* Send the content of the ring without waiting, only on the A35_0 core */
+static void uart_tx_kick(void)
+{
+  USART_TypeDef *uart = hcom_uart[COM1].Instance;
+  unsigned long head = uart_tx_head;
+  unsigned long tail = uart_tx_tail;
+  unsigned long len;
+
+  if (!uart_tx_is_core0())
+  {
+    return;
+  }
+
+  if (uart_tx_dma_ready)
+  {
+    if (uart_tx_dma_len != 0U)
+    {
+      if (__HAL_DMA_GET_FLAG(&uart_tx_dma, DMA_FLAG_IDLE) == 0U)
+      {
+        return;
+      }
+      (void)HAL_DMA_PollForTransfer(&uart_tx_dma, HAL_DMA_FULL_TRANSFER, 0);
+      tail += uart_tx_dma_len;
+      uart_tx_tail = tail;
+      uart_tx_dma_len = 0;
+    }
+
+    if (head == tail)
+    {
+      return;
+    }
+
+    /* contiguous part of the ring */
+    len = head - tail;
+    if (len > UART_TX_RING_SIZE - (tail & UART_TX_RING_MASK))
+    {
+      len = UART_TX_RING_SIZE - (tail & UART_TX_RING_MASK);
+    }
+
+    if (HAL_DMA_Start(&uart_tx_dma,
+                      (uint32_t)(uintptr_t)&uart_tx_ring[tail & UART_TX_RING_MASK],
+                      (uint32_t)(uintptr_t)&uart->TDR, (uint32_t)len) == HAL_OK)
+    {
+      uart_tx_dma_len = len;
+      return;
+    }
+
+    /* continue with the TX FIFO */
+    uart_tx_dma_ready = false;
+  }
+
+  while ((tail != head) &&
+         (__HAL_UART_GET_FLAG(&hcom_uart[COM1], UART_FLAG_TXFNF) != 0U))
+  {
+    uart->TDR = (uint8_t)uart_tx_ring[tail & UART_TX_RING_MASK];
+    tail++;
+  }
+  uart_tx_tail = tail;
+}
+
+/* Copy one character in the ring, waiting for the A35_0 core when it is full */
+static void uart_tx_put(char c)
+{
+  if (!uart_tx_ready)
+  {
+    (void)HAL_UART_Transmit(&hcom_uart[COM1], (uint8_t *)&c, 1,
+                            HAL_TIMEOUT_VALUE);
+    return;
+  }
+
+  if ((uart_tx_head - uart_tx_tail) >= UART_TX_RING_SIZE)
+  {
+    uart_tx_overflow++;
+    while ((uart_tx_head - uart_tx_tail) >= UART_TX_RING_SIZE)
+    {
+      uart_tx_kick();
+    }
+  }
+
+  uart_tx_ring[uart_tx_head & UART_TX_RING_MASK] = c;
+  uart_tx_dmb();
+  uart_tx_head = uart_tx_head + 1U;
+
+  uart_tx_kick();
+}
+
 /**
   * @brief  This function is executed to configure in case of error occurrence.
   * @param  None
@@ -52,7 +222,6 @@ void UART_Config(void)
 {
   COM_InitTypeDef COM_Init;
 
-  BSP_COM_SelectLogPort(COM1);
   COM_Init.BaudRate   = UTIL_UART_BAUDRATE;
   COM_Init.Parity     = (COM_ParityTypeDef)UTIL_UART_PARITY;
   COM_Init.StopBits   = (COM_StopBitsTypeDef)UTIL_UART_STOPBITS;
@@ -78,6 +247,9 @@ void UART_Config(void)
     Error_Handler();
   }
 
+  uart_tx_dma_setup();
+  uart_tx_ready = true;
+
   /* Output a message on Hyperterminal using printf function */
   printf("\n\r=============== UTILITIES-DDR Tool ===============\r");
   printf("\n\rModel: %s \r", UTIL_MODEL);
@@ -109,6 +281,7 @@ uint32_t Serial_Scanf(uint32_t value)
   uint16_t tmp = 0;
 
 #ifndef __TERMINAL_IO__
+  UART_Tx_Flush();
   __HAL_UART_CLEAR_OREFLAG(&hcom_uart[COM1]);
   /* e.g. read a character from the EVAL_COM1 and Loop until RXNE = 1 */
   HAL_UART_Receive(&hcom_uart[COM1], (uint8_t *)&tmp, 1, HAL_TIMEOUT_VALUE);
@@ -131,8 +304,7 @@ uint32_t Serial_Scanf(uint32_t value)
 void Serial_Putchar(char value)
 {
 #ifndef __TERMINAL_IO__
-  /* e.g. read a character from the EVAL_COM1 and Loop until RXNE = 1 */
-  HAL_UART_Transmit(&hcom_uart[COM1], (uint8_t *)&value, 1, HAL_TIMEOUT_VALUE);
+  uart_tx_put(value);
 #endif
 }
 
@@ -144,11 +316,254 @@ void Serial_Putchar(char value)
 void Serial_Printf(char *value, int len)
 {
 #ifndef __TERMINAL_IO__
-  /* e.g. read a character from the EVAL_COM1 and Loop until RXNE = 1 */
-  HAL_UART_Transmit(&hcom_uart[COM1], (uint8_t *)value, len, HAL_TIMEOUT_VALUE);
+  int i;
+
+  for (i = 0; i < len; i++)
+  {
+    uart_tx_put(value[i]);
+  }
 #endif
 }
 
+/**
+  * @brief  Send the console output copied in the ring since the last call,
+  *         without waiting.
+  * @param  None
+  * @retval None
+  */
+void UART_Tx_Poll(void)
+{
+  if (uart_tx_ready)
+  {
+    uart_tx_kick();
+  }
+}
+
+/**
+  * @brief  Wait until the console output is sent, on the A35_0 core.
+  * @param  None
+  * @retval None
+  */
+void UART_Tx_Flush(void)
+{
+  if (!uart_tx_ready || !uart_tx_is_core0())
+  {
+    return;
+  }
+
+  while ((uart_tx_tail != uart_tx_head) || (uart_tx_dma_len != 0U))
+  {
+    uart_tx_kick();
+  }
+
+  while (__HAL_UART_GET_FLAG(&hcom_uart[COM1], UART_FLAG_TC) == 0U)
+  {
+  }
+}
+
+/* USART kernel clock, after the prescaler */
+static uint32_t uart_ker_freq(void)
+{
+  uint32_t source = 0;
+
+  UART_GETCLOCKSOURCE(&hcom_uart[COM1], source);
+
+  return HAL_RCCEx_GetPeriphCLKFreq(source) /
+         UARTPrescTable[hcom_uart[COM1].Init.ClockPrescaler];
+}
+
+/*
+ * USARTDIV of 'baudrate' with 16 or 8 times oversampling, rounded as in
+ * HAL_UART_Init(), and the baud rate error in per mille (ULONG_MAX when the
+ * divider is out of range).
+ */
+static unsigned long uart_div(uint32_t freq, uint32_t baudrate, bool over8,
+                              unsigned long *error)
+{
+  unsigned long clk = over8 ? 2UL * freq : freq;
+  unsigned long div = (clk + baudrate / 2U) / baudrate;
+  unsigned long actual;
+
+  if ((div < UART_DIV_MIN) || (div > UART_DIV_MAX))
+  {
+    *error = ULONG_MAX;
+    return 0;
+  }
+
+  actual = clk / div;
+  *error = (actual > baudrate) ? actual - baudrate : baudrate - actual;
+  *error = (*error * 1000UL) / baudrate;
+
+  return div;
+}
+
+/* BRR and OVER8 change, the UART is disabled meanwhile */
+static void uart_set_brr(uint32_t brr, bool over8)
+{
+  USART_TypeDef *uart = hcom_uart[COM1].Instance;
+
+  __HAL_UART_DISABLE(&hcom_uart[COM1]);
+  MODIFY_REG(uart->CR1, USART_CR1_OVER8, over8 ? USART_CR1_OVER8 : 0U);
+  WRITE_REG(uart->BRR, brr);
+  __HAL_UART_ENABLE(&hcom_uart[COM1]);
+}
+
+/* wait for Enter, the characters received with an error are ignored */
+static bool uart_wait_enter(unsigned long timeout_s)
+{
+  USART_TypeDef *uart = hcom_uart[COM1].Instance;
+  uint64_t timeout;
+  uint32_t isr;
+  uint8_t ch;
+
+  /* HAL_GetTick() is not incremented: timeout based on the generic timer */
+  timeout = timer_get_count() + (uint64_t)timer_get_freq() * timeout_s;
+  while (timer_get_count() < timeout)
+  {
+    isr = READ_REG(uart->ISR);
+    if ((isr & UART_FLAG_RXNE) == 0U)
+    {
+      continue;
+    }
+
+    ch = (uint8_t)READ_REG(uart->RDR);
+    __HAL_UART_CLEAR_FLAG(&hcom_uart[COM1], UART_CLEAR_OREF | UART_CLEAR_FEF |
+                                            UART_CLEAR_NEF | UART_CLEAR_PEF);
+    if ((isr & (UART_FLAG_FE | UART_FLAG_NE | UART_FLAG_PE)) != 0U)
+    {
+      continue;
+    }
+
+    if ((ch == '\r') || (ch == '\n'))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+  * @brief  Print the console baud rate and the highest one reachable from the
+  *         USART kernel clock.
+  * @param  None
+  * @retval None
+  */
+void UART_Baudrate_Info(void)
+{
+  uint32_t freq = uart_ker_freq();
+
+  printf("baud = %lu, kernel clock %lu Hz, up to %lu\n\r",
+         (unsigned long)hcom_uart[COM1].Init.BaudRate, (unsigned long)freq,
+         (unsigned long)freq / 8UL);
+}
+
+/**
+  * @brief  Change the console baud rate: the terminal has UART_BAUD_TIMEOUT_S
+  *         seconds to follow and to answer with Enter at the new rate,
+  *         otherwise the previous rate is restored.
+  * @param  baudrate: new baud rate
+  * @retval true when the new baud rate is used
+  */
+bool UART_Set_Baudrate(uint32_t baudrate)
+{
+  USART_TypeDef *uart = hcom_uart[COM1].Instance;
+  uint32_t freq = uart_ker_freq();
+  uint32_t brr = READ_REG(uart->BRR);
+  bool over8 = READ_BIT(uart->CR1, USART_CR1_OVER8) != 0U;
+  bool new_over8 = false;
+  unsigned long div = 0;
+  unsigned long div8;
+  unsigned long error = ULONG_MAX;
+  unsigned long error8;
+
+  if (baudrate != 0U)
+  {
+    /*
+     * Oversampling with the lowest baud rate error for this kernel clock,
+     * 16 times when equal as it tolerates more clock deviation.
+     */
+    div = uart_div(freq, baudrate, false, &error);
+    div8 = uart_div(freq, baudrate, true, &error8);
+    if (error8 < error)
+    {
+      new_over8 = true;
+      div = div8;
+      error = error8;
+    }
+  }
+
+  if (error > UART_BAUD_ERROR_MAX)
+  {
+    printf("baud %lu not reachable with the kernel clock %lu Hz\n\r",
+           (unsigned long)baudrate, (unsigned long)freq);
+    return false;
+  }
+
+  printf("baud %lu: change the terminal and press Enter within %lu s\n\r",
+         (unsigned long)baudrate, UART_BAUD_TIMEOUT_S);
+  UART_Tx_Flush();
+
+  /* discard the characters received at the previous rate */
+  while (__HAL_UART_GET_FLAG(&hcom_uart[COM1], UART_FLAG_RXNE) != 0U)
+  {
+    (void)READ_REG(uart->RDR);
+  }
+
+  /* with OVER8, BRR[2:0] = USARTDIV[3:0] >> 1 */
+  if (new_over8)
+  {
+    div = (div & 0xFFF0UL) | ((div & 0xFUL) >> 1);
+  }
+
+  uart_set_brr((uint32_t)div, new_over8);
+  if (!uart_wait_enter(UART_BAUD_TIMEOUT_S))
+  {
+    uart_set_brr(brr, over8);
+    printf("baud %lu: no answer, back to %lu\n\r", (unsigned long)baudrate,
+           (unsigned long)hcom_uart[COM1].Init.BaudRate);
+    return false;
+  }
+
+  hcom_uart[COM1].Init.BaudRate = baudrate;
+  hcom_uart[COM1].Init.OverSampling = new_over8 ? UART_OVERSAMPLING_8 :
+                                                  UART_OVERSAMPLING_16;
+  UART_Baudrate_Info();
+
+  return true;
+}
+
+/**
+  * @brief  Print the console output counters.
+  * @param  None
+  * @retval None
+  */
+void UART_Tx_Info(void)
+{
+  printf("console = %lu bytes sent by %s, %lu bytes ring full %lu times\n\r",
+         uart_tx_tail, uart_tx_dma_ready ? "DMA" : "TX FIFO",
+         UART_TX_RING_SIZE, uart_tx_overflow);
+}
+
+#ifdef __GNUC__
+int __io_putchar(int ch)
+{
+  uart_tx_put((char)ch);
+
+  return ch;
+}
+
+int __io_getchar(void)
+{
+  uint8_t ch = 0;
+
+  UART_Tx_Flush();
+  (void)HAL_UART_Receive(&hcom_uart[COM1], &ch, 1, HAL_TIMEOUT_VALUE);
+
+  return ch;
+}
+#endif /* __GNUC__ */
+
 /**
   * @brief  This function is executed in case of error occurrence.
   * @param  None
@@ -160,23 +575,19 @@ void Error_Handler(void)
   /* Turn LED3 on */
   BSP_LED_Off(LED3);
 
+  UART_Tx_Flush();
+
   /* User may add here some code to deal with this error */
   while(1)
   {
     HAL_Delay(5000);
     printf("\n\r Error Handler \n\r");
     log_dbg("\n\r Why is there an error? \n\r");
+    UART_Tx_Flush();
   }
 }
 
 void valid_delay_us(unsigned long delay_us)
 {
-  __IO uint32_t wait_loop_index = 0U;
-
-  wait_loop_index = (delay_us * (SystemCoreClock / (1000000UL * 2UL)));
-
-  while(wait_loop_index != 0UL)
-  {
-    wait_loop_index--;
-  }
+  HAL_DelayUs((uint32_t)delay_us);
 }
@@ -80,6 +80,7 @@ int main(void)
   iddr.self_refresh = false;
   iddr.zdata = 0;
   iddr.clear_bkp = false;
+  iddr.restore_training = false;
 
   if (HAL_DDR_Init(&iddr) != HAL_OK)
   {
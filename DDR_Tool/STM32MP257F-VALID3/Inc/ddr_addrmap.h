@@ -0,0 +1,47 @@
+/**
+  ******************************************************************************
+  * @file    ddr_addrmap.h
+  * @author  MCD Application Team
+  * @brief   Header for ddr_addrmap.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DDR_ADDRMAP_H
+#define __DDR_ADDRMAP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Location of an address in the DDR devices */
+typedef struct {
+  unsigned long rank;
+  unsigned long bg;
+  unsigned long bank;
+  unsigned long row;
+  unsigned long col;
+} ddr_addrmap_loc;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void DDR_AddrMap_Update(void);
+void DDR_AddrMap_Get_Size(ddr_addrmap_loc *size);
+unsigned long DDR_AddrMap_Get_Unit(void);
+bool DDR_AddrMap_Decode(unsigned long addr, ddr_addrmap_loc *loc);
+unsigned long DDR_AddrMap_Encode(const ddr_addrmap_loc *loc);
+void DDR_AddrMap_Print(void);
+
+#endif /* __DDR_ADDRMAP_H */
@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_latency.h
+  * @author  MCD Application Team
+  * @brief   Header for ddr_tool_latency.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DDR_TOOL_LATENCY_H
+#define __DDR_TOOL_LATENCY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+  DDR_LAT_ALL = 0,
+  DDR_LAT_HIT,
+  DDR_LAT_MISS,
+  DDR_LAT_CONFLICT,
+  DDR_LAT_RANDOM,
+  DDR_LAT_STRIDE,
+} ddr_lat_chain;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+bool DDR_Latency_Run(ddr_lat_chain chain, unsigned long stride,
+                     unsigned long size, unsigned long addr);
+
+#endif /* __DDR_TOOL_LATENCY_H */
@@ -0,0 +1,47 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_smp.h
+  * @author  MCD Application Team
+  * @brief   Header for ddr_tool_smp.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DDR_TOOL_SMP_H
+#define __DDR_TOOL_SMP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables ------------------------------------------------------- */
+/* read by the startup code of the A35_1 core, before the bss initialization */
+extern volatile uintptr_t ddr_smp_core1_entry;
+extern volatile uintptr_t ddr_smp_core1_sp;
+
+/* Exported functions ------------------------------------------------------- */
+bool DDR_Smp_Set_Enable(bool enable);
+bool DDR_Smp_Get_Enable(void);
+uint32_t DDR_Smp_Run(uint32_t (*fct)(), uint8_t nb_args,
+                     const unsigned long *arg);
+uint32_t DDR_Smp_Run_Core1(uint32_t (*fct)(void));
+int DDR_Smp_Printf(const char *format, ...);
+int DDR_Smp_Vprintf(const char *format, va_list args);
+void DDR_Smp_Write(const void *buf, size_t len);
+
+#endif /* __DDR_TOOL_SMP_H */
@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_tlm.h
+  * @author  MCD Application Team
+  * @brief   Header for ddr_tool_tlm.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DDR_TOOL_TLM_H
+#define __DDR_TOOL_TLM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/*
+ * Records of the telemetry frames, fields in little endian, strings
+ * terminated by '\0' except the last one of the record:
+ * RESULT   id u8, flags u8, result u32, speed kHz u32, written u64, read u64,
+ *          elapsed us u64, test name, DDR name
+ * ERROR    core u8, address u64, expected u64, actual u64
+ * REG_NAME id u16, base, section, register name
+ * REG      id of the 1st value u16, values u32 of consecutive ids
+ * SAMPLE   tag, label, values u64 (the label may be empty)
+ */
+typedef enum {
+  DDR_TLM_RESULT = 1,
+  DDR_TLM_ERROR,
+  DDR_TLM_REG_NAME,
+  DDR_TLM_REG,
+  DDR_TLM_SAMPLE,
+} ddr_tlm_type;
+
+/* Exported constants --------------------------------------------------------*/
+/*
+ * Frame: sync (2 bytes), type u8, payload length u16, payload, CRC u16
+ * (CRC-16/CCITT-FALSE of the type, the length and the payload)
+ */
+#define DDR_TLM_SYNC0           0xA5U
+#define DDR_TLM_SYNC1           0x5AU
+#define DDR_TLM_HEADER_SIZE     5U
+#define DDR_TLM_CRC_SIZE        2U
+#define DDR_TLM_PAYLOAD_MAX     256U
+#define DDR_TLM_FRAME_MAX       (DDR_TLM_HEADER_SIZE + DDR_TLM_PAYLOAD_MAX + \
+                                 DDR_TLM_CRC_SIZE)
+
+/* RESULT flags */
+#define DDR_TLM_FLAG_SMP        0x1U
+#define DDR_TLM_FLAG_WB         0x2U
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void DDR_Tlm_Set_Enable(bool enable);
+bool DDR_Tlm_Get_Enable(void);
+uint16_t DDR_Tlm_Crc(const uint8_t *data, size_t len);
+void DDR_Tlm_Result(int id, uint8_t flags, uint32_t result, uint32_t speed,
+                    unsigned long written, unsigned long read,
+                    unsigned long elapsed_us, const char *test_name,
+                    const char *ddr_name);
+void DDR_Tlm_Errors_Reset(void);
+void DDR_Tlm_Error(unsigned int core, unsigned long addr,
+                   unsigned long expected, unsigned long actual);
+void DDR_Tlm_Sample(const char *tag, const char *label,
+                    const unsigned long *value, unsigned int nb);
+void DDR_Tlm_Reg(const char *base, const char *section, const char *name,
+                 uint32_t value);
+void DDR_Tlm_Flush(void);
+
+#endif /* __DDR_TOOL_TLM_H */
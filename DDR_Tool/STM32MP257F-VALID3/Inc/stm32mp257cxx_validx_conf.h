@@ -27,8 +27,8 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32mp2xx_hal.h"
 
-/* COM define */
-#define USE_COM_LOG                         1U
+/* COM define: __io_putchar() in ddr_tool_util.c */
+#define USE_COM_LOG                         0U
 #define USE_BSP_COM_FEATURE                 1U
 
 /* LCD controllers defines */
@@ -19,36 +19,381 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32_device_hal.h"
 
+#include "stdarg.h"
 #include "stdio.h"
 #include "stdlib.h"
 #include "string.h"
 #include "log.h"
 #include "ddr_tests.h"
+#include "ddr_addrmap.h"
+#include "ddr_tool_tlm.h"
+#include "system_time.h"
 
 #include "stm32mp_util_conf.h"
 #include "stm32mp_util_ddr_conf.h"
 
+#ifdef __AARCH64__
+#include "ddr_tool_smp.h"
+#include "ddr_tool_trace.h"
+#include "ddr_tool_util.h"
+#endif
+
 /* Private typedef -----------------------------------------------------------*/
+/* Mismatches accumulated by the verify loops */
+typedef struct {
+  unsigned long words;
+  unsigned long bits;
+  unsigned long first;
+  unsigned long last;
+  unsigned long bit[sizeof(unsigned long) * 8];
+  unsigned long byte[sizeof(unsigned long)];
+} ddr_test_errors;
+
 /* Private define ------------------------------------------------------------*/
 #define DDR_BASE_ADDR                        0x80000000
+#define DDRCTRL_MSTR_DATA_BUS_WIDTH_HALF     DDRC_MSTR_DATA_BUS_WIDTH_0
+#define DDRCTRL_MSTR_DATA_BUS_WIDTH_QUARTER  DDRC_MSTR_DATA_BUS_WIDTH_1
+#define DDR_TEST_CORE_NB                     2
+#define DDR_CACHE_LINE                       64
+#define DDR_CACHE_LINE_WORDS                 (DDR_CACHE_LINE / sizeof(unsigned long))
+
+/* DDR 1GB blocks of the EL3 first-level table (see minimal_startup64_a35.s) */
+#define DDR_TTB_BLOCK_SHIFT                  30
+#define DDR_TTB_BLOCK_NB                     4
+#define DDR_TTB_ATTR_INDX_Msk                (0x7UL << 2)
+#define DDR_TTB_ATTR_INDX_WB                 (0x2UL << 2) /* MAIR ATTR2 */
+#define DDR_TTB_ATTR_INDX_NC                 (0x3UL << 2) /* MAIR ATTR3 */
+
+/*
+ * Pseudo random generator: the words of each chunk are produced by
+ * DDR_PRNG_LANES interleaved xorshift64 streams, whose states are derived
+ * from the seed and the chunk index (jump-ahead without serial dependence).
+ */
+#define DDR_PRNG_CHUNK                       512
+#define DDR_PRNG_CHUNK_WORDS                 (DDR_PRNG_CHUNK / sizeof(unsigned long))
+#define DDR_PRNG_LANES                       2
+#define DDR_PRNG_GAMMA                       0x9E3779B97F4A7C15UL
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/* traffic and mismatches are accounted per core, merged when read */
+static ddr_test_stats test_stats[DDR_TEST_CORE_NB];
+static ddr_test_errors test_errors[DDR_TEST_CORE_NB];
+static bool test_continue;
+/* 0 = new seed for each test */
+static unsigned long test_seed;
+/* region of the background DMA traffic (see ddr_tool_dma.c), 0 = none */
+static unsigned long reserved_addr;
+static unsigned long reserved_size;
+/* seed shared by both cores of a split test, 0 = none */
+static volatile uint64_t smp_seed;
+
+#ifdef __AARCH64__
+extern uint64_t mp2_el3_ttb0_base[];
+
+/* DDR mapped non-cacheable by the startup code */
+static bool test_cache;
+#else
+/* host memory is always cacheable */
+static bool test_cache = true;
+#endif
+
 /* Private function prototypes -----------------------------------------------*/
+static int test_printf(const char *format, ...)
+  __attribute__((format(printf, 1, 2)));
+static int test_info(const char *format, ...)
+  __attribute__((format(printf, 1, 2)));
+
 /* Private functions ---------------------------------------------------------*/
+/* the tests may run on both cores: output serialized (see ddr_tool_smp.c) */
+static int test_vprintf(const char *format, va_list args)
+{
+#ifdef __AARCH64__
+  return DDR_Smp_Vprintf(format, args);
+#else
+  return vprintf(format, args);
+#endif
+}
+
+/*
+ * Failures and their diagnostics: printed with "tlm on" too, as text between
+ * the frames (see ddr_tool_tlm.c)
+ */
+static int test_printf(const char *format, ...)
+{
+  va_list args;
+  int ret;
+
+  va_start(args, format);
+  ret = test_vprintf(format, args);
+  va_end(args);
+
+  return ret;
+}
+
+/* progress and measures: with "tlm on", sent as frames only */
+static int test_info(const char *format, ...)
+{
+  va_list args;
+  int ret = 0;
+
+  if (!DDR_Tlm_Get_Enable())
+  {
+    va_start(args, format);
+    ret = test_vprintf(format, args);
+    va_end(args);
+  }
+
+  return ret;
+}
+
+static unsigned int get_core_id(void)
+{
+#ifdef __AARCH64__
+  uint64_t mpidr;
+
+  __asm volatile("MRS %0, MPIDR_EL1" : "=r" (mpidr));
+
+  return (unsigned int)(mpidr & (DDR_TEST_CORE_NB - 1));
+#else
+  return 0;
+#endif
+}
+
+static void cache_clean_invalidate(const void *addr)
+{
+#ifdef __AARCH64__
+  __asm volatile("DC CIVAC, %0" : : "r" (addr) : "memory");
+#endif
+}
+
+static void cache_zero(void *addr)
+{
+#ifdef __AARCH64__
+  __asm volatile("DC ZVA, %0" : : "r" (addr) : "memory");
+#endif
+}
+
+static void cache_sync(void)
+{
+#ifdef __AARCH64__
+  __asm volatile("DSB SY" : : : "memory");
+#endif
+}
+
+/* DC ZVA allowed and zeroing exactly one cache line */
+static bool cache_zero_usable(void)
+{
+#ifdef __AARCH64__
+  uint64_t dczid;
+
+  __asm volatile("MRS %0, DCZID_EL0" : "=r" (dczid));
+
+  return ((dczid & 0x10U) == 0U) &&
+         ((4UL << (dczid & 0xFU)) == DDR_CACHE_LINE);
+#else
+  return false;
+#endif
+}
+
+#ifdef __AARCH64__
+/* clean and invalidate all the data cache levels by set/way */
+static void cache_flush_all(void)
+{
+  uint64_t clidr;
+  uint64_t ccsidr;
+  uint32_t level;
+  uint32_t line_shift;
+  uint32_t way_shift;
+  uint32_t ways;
+  uint32_t sets;
+  uint32_t way;
+  uint32_t set;
+
+  __asm volatile("MRS %0, CLIDR_EL1" : "=r" (clidr));
+
+  for (level = 0; level < ((clidr >> 24) & 0x7U); level++)
+  {
+    /* no data or unified cache at this level */
+    if (((clidr >> (level * 3)) & 0x7U) < 2U)
+    {
+      continue;
+    }
+
+    __asm volatile("MSR CSSELR_EL1, %0\n"
+                   "ISB\n" : : "r" ((uint64_t)level << 1));
+    __asm volatile("MRS %0, CCSIDR_EL1" : "=r" (ccsidr));
+
+    line_shift = (ccsidr & 0x7U) + 4;
+    ways = ((ccsidr >> 3) & 0x3FFU) + 1;
+    sets = ((ccsidr >> 13) & 0x7FFFU) + 1;
+    way_shift = (ways > 1U) ? __builtin_clz(ways - 1) : 0;
+
+    for (way = 0; way < ways; way++)
+    {
+      for (set = 0; set < sets; set++)
+      {
+        __asm volatile("DC CISW, %0" : : "r" (((uint64_t)way << way_shift) |
+                                              ((uint64_t)set << line_shift) |
+                                              ((uint64_t)level << 1)));
+      }
+    }
+  }
+
+  __asm volatile("DSB SY\n"
+                 "ISB\n" : : : "memory");
+}
+
+/*
+ * Local invalidation of the EL3 TLB: CPUECTLR_EL1.SMPEN is cleared by the
+ * startup code, so the TLB maintenance is not broadcast to the other core.
+ */
+static uint32_t tlb_invalidate(void)
+{
+  __asm volatile("DSB SY\n"
+                 "TLBI ALLE3\n"
+                 "DSB SY\n"
+                 "ISB\n" : : : "memory");
+
+  return 0;
+}
+
+/*
+ * Change the memory attributes of the DDR blocks in the EL3 table, with a
+ * break-before-make sequence as the memory type of a live entry changes.
+ */
+static void ttb_set_ddr_attr(unsigned long attr)
+{
+  unsigned long first = DDR_BASE_ADDR >> DDR_TTB_BLOCK_SHIFT;
+  unsigned long nb;
+  unsigned long i;
+  uint64_t entry;
+
+  nb = ((unsigned long)DDR_MEM_SIZE + (1UL << DDR_TTB_BLOCK_SHIFT) - 1) >>
+       DDR_TTB_BLOCK_SHIFT;
+  if (nb > DDR_TTB_BLOCK_NB)
+  {
+    nb = DDR_TTB_BLOCK_NB;
+  }
+
+  for (i = first; i < first + nb; i++)
+  {
+    entry = (mp2_el3_ttb0_base[i] & ~DDR_TTB_ATTR_INDX_Msk) | attr;
+
+    /* break: invalid entry, no cached translation left */
+    mp2_el3_ttb0_base[i] = 0;
+    cache_clean_invalidate(&mp2_el3_ttb0_base[i]);
+    (void)tlb_invalidate();
+
+    /* make: entry with the new attributes */
+    mp2_el3_ttb0_base[i] = entry;
+    cache_clean_invalidate(&mp2_el3_ttb0_base[i]);
+  }
+
+  __asm volatile("DSB SY\n"
+                 "ISB\n" : : : "memory");
+}
+#endif /* __AARCH64__ */
+
+static void test_stats_add(unsigned long written, unsigned long read)
+{
+  ddr_test_stats *stats = &test_stats[get_core_id()];
+
+  stats->written += written;
+  stats->read += read;
+}
+
+static int get_bus_width(void)
+{
+  switch (READ_REG(DDRC->MSTR) & DDRC_MSTR_DATA_BUS_WIDTH_Msk)
+  {
+    case DDRCTRL_MSTR_DATA_BUS_WIDTH_HALF:
+    case DDRCTRL_MSTR_DATA_BUS_WIDTH_QUARTER:
+      return 16;
+    default:
+      return 32;
+  }
+}
+
+/*
+ * Record a mismatch of a verify loop, only called on the failure path.
+ * Return true when the test must stop (default), false in continue-on-error
+ * mode.
+ */
+static bool test_error(const uintptr_t *addr, unsigned long expected,
+                       unsigned long actual)
+{
+  ddr_test_errors *errors = &test_errors[get_core_id()];
+  unsigned long diff = expected ^ actual;
+  uint32_t lanes = 0;
+  unsigned int i;
+
+  if (DDR_Tlm_Get_Enable())
+  {
+    DDR_Tlm_Error(get_core_id(), (unsigned long)addr, expected, actual);
+  }
+
+  if (errors->words == 0U)
+  {
+    errors->first = (unsigned long)addr;
+  }
+  errors->last = (unsigned long)addr;
+  errors->words++;
+
+  for (i = 0; i < sizeof(unsigned long); i++)
+  {
+    if (((diff >> (i * 8)) & 0xFFUL) != 0U)
+    {
+      errors->byte[i]++;
+      lanes |= 1U << i;
+    }
+  }
+
+#ifdef __AARCH64__
+  /* the 1st mismatch only, the ring keeps the other events */
+  if (errors->words == 1U)
+  {
+    DDR_Trace(DDR_TRACE_TEST_ERROR, lanes, (unsigned long)addr);
+  }
+#else
+  (void)lanes;
+#endif
+
+  while (diff != 0U)
+  {
+    errors->bit[__builtin_ctzl(diff)]++;
+    errors->bits++;
+    diff &= diff - 1;
+  }
+
+  return !test_continue;
+}
+
+/* print the DDR device location of a failing address */
+static void addrmap_print_loc(const char *prefix, unsigned long addr)
+{
+  ddr_addrmap_loc loc;
+
+  if (DDR_AddrMap_Decode(addr, &loc))
+  {
+    test_printf("  %srank %lu, bg %lu, bank %lu, row 0x%lx, col 0x%lx\n\r",
+                prefix, loc.rank, loc.bg, loc.bank, loc.row, loc.col);
+  }
+}
+
 static int get_addr(unsigned long addr_in, uintptr_t **addr)
 {
   if (addr_in != 0UL)
   {
     if (addr_in < DDR_MEM_BASE)
     {
-      printf("Address too low: 0x%lx\n\r", addr_in);
+      test_printf("Address too low: 0x%lx\n\r", addr_in);
       return -1;
     }
 
     if ((addr_in & 0x3UL) != 0UL)
     {
-      printf("Unaligned address: 0x%lx\n\r", addr_in);
+      test_printf("Unaligned address: 0x%lx\n\r", addr_in);
       return -1;
     }
 
@@ -62,6 +407,33 @@ static int get_addr(unsigned long addr_in, uintptr_t **addr)
   return 0;
 }
 
+/* the buffer of a test must not overlap the region of the DMA traffic */
+static int check_reserved(unsigned long addr, unsigned long size)
+{
+  if ((reserved_size != 0U) && (addr < reserved_addr + reserved_size) &&
+      (reserved_addr < addr + size))
+  {
+    test_printf("Buffer 0x%lx..0x%lx overlaps the DMA region 0x%lx..0x%lx\n\r",
+                addr, addr + size - 1U, reserved_addr,
+                reserved_addr + reserved_size - 1U);
+    return -1;
+  }
+
+  return 0;
+}
+
+/* address of a test buffer of size bytes */
+static int get_range(unsigned long addr_in, unsigned long size,
+                     uintptr_t **addr)
+{
+  if (get_addr(addr_in, addr) != 0)
+  {
+    return -1;
+  }
+
+  return check_reserved((unsigned long)*addr, size);
+}
+
 static void get_nb_loop(unsigned long loop_in, uint32_t *nb_loop,
                         uint32_t default_nb_loop)
 {
@@ -69,12 +441,12 @@ static void get_nb_loop(unsigned long loop_in, uint32_t *nb_loop,
   {
     if (loop_in == 0xFFFFFFFF)
     {
-      printf("Warning: infinite loop requested\n\r");
+      test_printf("Warning: infinite loop requested\n\r");
     }
 
     if (loop_in > 0xFFFFFFFF)
     {
-      printf("Warning: incorrect loop_number, forced to default value\n\r");
+      test_printf("Warning: incorrect loop_number, forced to default value\n\r");
       *nb_loop = default_nb_loop;
     }
     else
@@ -95,14 +467,14 @@ static int get_buf_size(unsigned long size_in, unsigned long *size,
   {
     if ((size_in < min_size) || (size_in > (unsigned long)DDR_MEM_SIZE))
     {
-      printf("Invalid size: 0x%lx\n\r", size_in);
-      printf("  (range = 0x%lx..0x%lx)\n\r", min_size, (unsigned long)DDR_MEM_SIZE);
+      test_printf("Invalid size: 0x%lx\n\r", size_in);
+      test_printf("  (range = 0x%lx..0x%lx)\n\r", min_size, (unsigned long)DDR_MEM_SIZE);
       return -1;
     }
 
     if ((size_in & (min_size - 1)) != 0)
     {
-      printf("Unaligned size: 0x%lx (min=0x%lx)\n\r", size_in, min_size);
+      test_printf("Unaligned size: 0x%lx (min=0x%lx)\n\r", size_in, min_size);
       return -1;
     }
 
@@ -134,142 +506,448 @@ static void get_pattern(unsigned long pattern_in, unsigned long *pattern,
   }
 }
 
-static int test_loop_end(uint32_t *loop, uint32_t nb_loop)
+/* splitmix64 finalizer, never 0 as it seeds a xorshift state */
+static uint64_t prng_mix(uint64_t z)
 {
-  (*loop)++;
-  if (nb_loop && *loop >= nb_loop)
-  {
-    return 1;
-  }
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+  z ^= z >> 31;
 
-  return 0;
+  return (z != 0U) ? z : DDR_PRNG_GAMMA;
 }
 
-/**
-* @brief test_databus.
-* @par Test Description
-*   Verifies each data line by walking 1 on fixed address.
-*   Test the data bus wiring in a memory region by performing
-*   a walking 1's test at a fixed address within that region.
-* @par Test Hardware Connection
-* - None
-* @par Required preconditions
-* - None
-* @par Expected result
-* - None
-* @par Called functions
-* - None
-* @par Used Peripherals
-* - None,...
-* @retval
-*  0: Test passed
-*  Value different from 0: Test failed
-*  None(0xFF): if the result is deduced by the user: waveform, event...
-*/
-uint32_t DDR_Test_Databus(unsigned long addr_in)
+static uint64_t prng_next(uint64_t *state)
 {
-  unsigned long pattern;
-  uintptr_t *addr = NULL;
+  uint64_t x = *state;
 
-  if (get_addr(addr_in, &addr) != 0)
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+
+  return x;
+}
+
+/* jump to the 1st word of a chunk: one state per lane */
+static void prng_chunk(uint64_t seed, unsigned long chunk, uint64_t *state)
+{
+  unsigned int lane;
+
+  for (lane = 0; lane < DDR_PRNG_LANES; lane++)
   {
-    return 1;
+    state[lane] = prng_mix(seed + ((chunk * DDR_PRNG_LANES) + lane + 1) *
+                                  DDR_PRNG_GAMMA);
   }
+}
 
-  for (pattern = 1U; pattern != 0U; pattern <<= 1)
-  {
-    *addr = pattern;
+/* seed of a test: the selected one, or a new one from the generic timer */
+static uint64_t prng_seed(void)
+{
+  uint64_t seed = test_seed;
 
-    if (*addr != pattern)
-    {
-      printf("  test_databus KO @ 0x%lx \n\r", (unsigned long)addr);
-      return 2;
-    }
+  if (seed == 0U)
+  {
+#ifdef __AARCH64__
+    __asm volatile("ISB\n"
+                   "MRS %0, CNTPCT_EL0\n" : "=r" (seed));
+#else
+    seed = DDR_PRNG_GAMMA;
+#endif
   }
 
-  return 0;
+  return seed;
 }
 
-static int test_databuswalk(uint8_t mode, unsigned long loop_in, unsigned long addr_in)
+static int test_loop_end(uint32_t *loop, uint32_t nb_loop)
 {
-  int i;
-  uintptr_t *addr = NULL;
-  unsigned long data;
-  unsigned long error = 0U;
-  uint32_t loop = 0;
-  uint32_t nb_loop;
-
-  get_nb_loop(loop_in, &nb_loop, 100);
+#ifdef __AARCH64__
+  /* send the output of the previous loop */
+  UART_Tx_Poll();
+#endif
 
-  if (get_addr(addr_in, &addr) != 0)
+  (*loop)++;
+  if (nb_loop && *loop >= nb_loop)
   {
     return 1;
   }
 
-  while (error == 0U)
-  {
-    for (i = 0; i < (int)(sizeof(unsigned long) * 8); i++)
-    {
-      unsigned long pattern = mode ? (1 << i) : ~(1 << i);
-
-      *(addr + sizeof(unsigned long) * i) = pattern;
-    }
-
-    for (i = 0; i < (int)(sizeof(unsigned long) * 8); i++)
-    {
-      unsigned long pattern = mode ? (1 << i) : ~(1 << i);
+  return 0;
+}
 
-      data = *(addr + sizeof(unsigned long) * i);
-      if (pattern !=  data)
-      {
-        error |= 1 << i;
-        printf("  0x%lx: error 0x%lx expected 0x%lx => error:0x%lx\n\r",
-               (unsigned long)(addr + sizeof(unsigned long) * i), data, pattern, error);
-      }
-    }
+/**
+* @brief Reset the DDR traffic counters of the tests.
+* @retval None
+*/
+void DDR_Test_Stats_Reset(void)
+{
+  memset(test_stats, 0, sizeof(test_stats));
+}
 
-    if (test_loop_end(&loop, nb_loop))
-    {
-      break;
-    }
+/**
+* @brief Get the DDR traffic counters of the tests.
+* @param stats: bytes written and read since DDR_Test_Stats_Reset()
+* @retval None
+*/
+void DDR_Test_Stats_Get(ddr_test_stats *stats)
+{
+  unsigned int core;
 
-    for (i = 0; i < (int)(sizeof(unsigned long) * 8); i++)
-    {
-      *(addr + sizeof(unsigned long) * i) = 0;
-    }
-  }
+  stats->written = 0;
+  stats->read = 0;
 
-  if (error != 0U)
+  for (core = 0; core < DDR_TEST_CORE_NB; core++)
   {
-    printf("  test_databuswalk%d KO\n\r", mode);
-    return 2;
+    stats->written += test_stats[core].written;
+    stats->read += test_stats[core].read;
   }
-
-  return 0;
 }
 
 /**
-* @brief test_databuswalk0.
-* @par Test Description
-*   Verifies each data bus signal can be driven low (32 word burst).
-* @par Test Hardware Connection
-* - None
-* @par Required preconditions
-* - None
-* @par Expected result
-* - None
-* @par Called functions
-* - xxx
-* @par Used Peripherals
-* - None,...
-* @retval
-*  0: Test passed
-*  Value different from 0: Test failed
-*  None(0xFF): if the result is deduced by the user: waveform, event...
+* @brief Select the behavior of the verify loops on mismatch.
+* @param enable: false = the test stops at the first mismatch (default)
+*                true = mismatches are accumulated until the end of the test
+* @retval None
 */
-uint32_t DDR_Test_DatabusWalk0(unsigned long loop, unsigned long addr)
+void DDR_Test_Set_Continue(bool enable)
 {
-  return test_databuswalk(0, loop, addr);
+  test_continue = enable;
+}
+
+/**
+* @brief Get the behavior of the verify loops on mismatch.
+* @retval true in continue-on-error mode
+*/
+bool DDR_Test_Get_Continue(void)
+{
+  return test_continue;
+}
+
+/**
+* @brief Select the mapping of the DDR: non-cacheable (default, every access
+*   is a single beat) or cacheable write-back (line fills and evictions).
+*   The data caches and the TLB of both cores are cleaned and invalidated
+*   after the change.
+* @param enable: true = cacheable write-back, false = non-cacheable
+* @retval true when the mapping is applied
+*/
+bool DDR_Test_Set_Cache(bool enable)
+{
+#ifdef __AARCH64__
+  ttb_set_ddr_attr(enable ? DDR_TTB_ATTR_INDX_WB : DDR_TTB_ATTR_INDX_NC);
+  cache_flush_all();
+  /* the A35_1 core invalidates its own TLB, then flushes its caches */
+  (void)DDR_Smp_Run_Core1(tlb_invalidate);
+  test_cache = enable;
+
+  return true;
+#else
+  return enable == test_cache;
+#endif
+}
+
+/**
+* @brief Get the mapping of the DDR.
+* @retval true when the DDR is mapped cacheable write-back
+*/
+bool DDR_Test_Get_Cache(void)
+{
+  return test_cache;
+}
+
+/**
+* @brief Write back and invalidate the data caches of the calling core,
+*   when the DDR is mapped cacheable.
+* @retval None
+*/
+void DDR_Test_Cache_Flush(void)
+{
+#ifdef __AARCH64__
+  if (test_cache)
+  {
+    cache_flush_all();
+  }
+#endif
+}
+
+/**
+* @brief Select the seed of the tests using pseudo random data, to replay a
+*   failing run: the seed is printed by each of these tests.
+* @param seed: seed of the next tests, 0 = new seed for each test (default)
+* @retval None
+*/
+void DDR_Test_Set_Seed(unsigned long seed)
+{
+  test_seed = seed;
+}
+
+/**
+* @brief Get the seed of the tests using pseudo random data.
+* @retval seed, 0 = new seed for each test
+*/
+unsigned long DDR_Test_Get_Seed(void)
+{
+  return test_seed;
+}
+
+/**
+* @brief Reserve a DDR region for the background DMA traffic: the tests
+*   refuse a buffer overlapping it.
+* @param addr: address of the region
+* @param size: size of the region, 0 = no reserved region
+* @retval None
+*/
+void DDR_Test_Set_Reserved(unsigned long addr, unsigned long size)
+{
+  reserved_addr = addr;
+  reserved_size = size;
+}
+
+/**
+* @brief Draw the seed of a test split on both cores, on the A35_0 core before
+*   the start of both parts: each core derives and prints its own seed from
+*   it, the seed of the A35_0 core being the drawn one.
+* @param start: true before the test, false after it
+* @retval None
+*/
+void DDR_Test_Smp_Seed(bool start)
+{
+  smp_seed = start ? prng_seed() : 0U;
+}
+
+/**
+* @brief Reset the accumulated mismatches.
+* @retval None
+*/
+void DDR_Test_Errors_Reset(void)
+{
+  memset(test_errors, 0, sizeof(test_errors));
+  DDR_Tlm_Errors_Reset();
+}
+
+/**
+* @brief Print the accumulated mismatches per byte lane and per DQ bit.
+*   The bits of the CPU word are folded on the DDR data bus width.
+* @retval Number of failing words since DDR_Test_Errors_Reset()
+*/
+unsigned long DDR_Test_Errors_Report(void)
+{
+  unsigned long dq[sizeof(unsigned long) * 8] = {0};
+  unsigned long lane[sizeof(unsigned long)] = {0};
+  unsigned long words = 0;
+  unsigned long bits = 0;
+  unsigned long first = 0;
+  unsigned long last = 0;
+  int bus_width;
+  unsigned int core;
+  unsigned int i;
+
+  bus_width = get_bus_width();
+
+  /* A35_1 tests the upper part of the range: merge in address order */
+  for (core = 0; core < DDR_TEST_CORE_NB; core++)
+  {
+    if (test_errors[core].words == 0U)
+    {
+      continue;
+    }
+
+    if (words == 0U)
+    {
+      first = test_errors[core].first;
+    }
+    last = test_errors[core].last;
+    words += test_errors[core].words;
+    bits += test_errors[core].bits;
+
+    for (i = 0; i < sizeof(unsigned long) * 8; i++)
+    {
+      dq[i % bus_width] += test_errors[core].bit[i];
+    }
+
+    for (i = 0; i < sizeof(unsigned long); i++)
+    {
+      lane[i % (bus_width / 8)] += test_errors[core].byte[i];
+    }
+  }
+
+  if (words == 0U)
+  {
+    return 0;
+  }
+
+  /* ERRORS;;<words>;<bits>;<first>;<last>;<errors of each byte lane> */
+  if (DDR_Tlm_Get_Enable())
+  {
+    unsigned long value[4 + sizeof(unsigned long)] = {words, bits, first, last};
+
+    for (i = 0; i < (unsigned int)bus_width / 8; i++)
+    {
+      value[4 + i] = lane[i];
+    }
+    DDR_Tlm_Sample("ERRORS", "", value, 4 + (unsigned int)bus_width / 8);
+
+    return words;
+  }
+
+  test_printf("  errors: %lu words, %lu bits, first @ 0x%lx, last @ 0x%lx\n\r",
+              words, bits, first, last);
+
+  DDR_AddrMap_Update();
+  addrmap_print_loc("first: ", first);
+  addrmap_print_loc("last : ", last);
+
+  test_printf("  byte lane:");
+  for (i = 0; i < (unsigned int)bus_width / 8; i++)
+  {
+    test_printf(" %d=%lu", i, lane[i]);
+  }
+  test_printf("\n\r");
+
+  test_printf("  DQ bit   :");
+  for (i = 0; i < (unsigned int)bus_width; i++)
+  {
+    if (dq[i] != 0U)
+    {
+      test_printf(" DQ%d=%lu", i, dq[i]);
+    }
+  }
+  test_printf("\n\r");
+
+  return words;
+}
+
+/**
+* @brief test_databus.
+* @par Test Description
+*   Verifies each data line by walking 1 on fixed address.
+*   Test the data bus wiring in a memory region by performing
+*   a walking 1's test at a fixed address within that region.
+* @par Test Hardware Connection
+* - None
+* @par Required preconditions
+* - None
+* @par Expected result
+* - None
+* @par Called functions
+* - None
+* @par Used Peripherals
+* - None,...
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*  None(0xFF): if the result is deduced by the user: waveform, event...
+*/
+uint32_t DDR_Test_Databus(unsigned long addr_in)
+{
+  unsigned long pattern;
+  unsigned long data;
+  uintptr_t *addr = NULL;
+
+  if (get_addr(addr_in, &addr) != 0)
+  {
+    return 1;
+  }
+
+  for (pattern = 1U; pattern != 0U; pattern <<= 1)
+  {
+    *addr = pattern;
+    test_stats_add(sizeof(unsigned long), sizeof(unsigned long));
+
+    data = *addr;
+    if ((data != pattern) && test_error(addr, pattern, data))
+    {
+      test_printf("  test_databus KO @ 0x%lx \n\r", (unsigned long)addr);
+      return 2;
+    }
+  }
+
+  return 0;
+}
+
+static int test_databuswalk(uint8_t mode, unsigned long loop_in, unsigned long addr_in)
+{
+  int i;
+  uintptr_t *addr = NULL;
+  unsigned long data;
+  unsigned long error = 0U;
+  uint32_t loop = 0;
+  uint32_t nb_loop;
+
+  get_nb_loop(loop_in, &nb_loop, 100);
+
+  if (get_addr(addr_in, &addr) != 0)
+  {
+    return 1;
+  }
+
+  while (error == 0U)
+  {
+    for (i = 0; i < (int)(sizeof(unsigned long) * 8); i++)
+    {
+      unsigned long pattern = mode ? (1 << i) : ~(1 << i);
+
+      *(addr + sizeof(unsigned long) * i) = pattern;
+    }
+    test_stats_add(sizeof(unsigned long) * 8 * sizeof(unsigned long), 0);
+
+    for (i = 0; i < (int)(sizeof(unsigned long) * 8); i++)
+    {
+      unsigned long pattern = mode ? (1 << i) : ~(1 << i);
+
+      data = *(addr + sizeof(unsigned long) * i);
+      if ((pattern != data) &&
+          test_error(addr + sizeof(unsigned long) * i, pattern, data))
+      {
+        error |= 1 << i;
+        test_printf("  0x%lx: error 0x%lx expected 0x%lx => error:0x%lx\n\r",
+                    (unsigned long)(addr + sizeof(unsigned long) * i), data, pattern, error);
+      }
+    }
+    test_stats_add(0, sizeof(unsigned long) * 8 * sizeof(unsigned long));
+
+    if (test_loop_end(&loop, nb_loop))
+    {
+      break;
+    }
+
+    for (i = 0; i < (int)(sizeof(unsigned long) * 8); i++)
+    {
+      *(addr + sizeof(unsigned long) * i) = 0;
+    }
+    test_stats_add(sizeof(unsigned long) * 8 * sizeof(unsigned long), 0);
+  }
+
+  if (error != 0U)
+  {
+    test_printf("  test_databuswalk%d KO\n\r", mode);
+    return 2;
+  }
+
+  return 0;
+}
+
+/**
+* @brief test_databuswalk0.
+* @par Test Description
+*   Verifies each data bus signal can be driven low (32 word burst).
+* @par Test Hardware Connection
+* - None
+* @par Required preconditions
+* - None
+* @par Expected result
+* - None
+* @par Called functions
+* - xxx
+* @par Used Peripherals
+* - None,...
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*  None(0xFF): if the result is deduced by the user: waveform, event...
+*/
+uint32_t DDR_Test_DatabusWalk0(unsigned long loop, unsigned long addr)
+{
+  return test_databuswalk(0, loop, addr);
 }
 
 /**
@@ -361,8 +1039,8 @@ uint32_t DDR_Test_AddressBus(unsigned long size_in, unsigned long addr_in)
     }
     else
     {
-      printf("DDR size too low for this test (0x%lx)\n\r",
-             (unsigned long)DDR_MEM_SIZE);
+      test_printf("DDR size too low for this test (0x%lx)\n\r",
+                  (unsigned long)DDR_MEM_SIZE);
 
       return 2;
     }
@@ -379,11 +1057,11 @@ uint32_t DDR_Test_AddressBus(unsigned long size_in, unsigned long addr_in)
 
   if (!is_power_of_2(size))
   {
-    printf("size 0x%lx is not a power of 2\n\r", size);
+    test_printf("size 0x%lx is not a power of 2\n\r", size);
     return 2;
   }
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, size, &addr) != 0)
   {
     return 3;
   }
@@ -397,10 +1075,12 @@ uint32_t DDR_Test_AddressBus(unsigned long size_in, unsigned long addr_in)
        offset <<= 1)
   {
     *(addr + offset) = pattern;
+    test_stats_add(sizeof(unsigned long), 0);
   }
 
   /* Check for address bits stuck high. */
   *(addr + testoffset) = antipattern;
+  test_stats_add(sizeof(unsigned long), 0);
 
   for (offset = 1U;
        ((offset & addressmask) != 0U) &&
@@ -408,15 +1088,17 @@ uint32_t DDR_Test_AddressBus(unsigned long size_in, unsigned long addr_in)
        offset <<= 1)
   {
     data = *(addr + offset);
-    if (data != pattern)
+    test_stats_add(0, sizeof(unsigned long));
+    if ((data != pattern) && test_error(addr + offset, pattern, data))
     {
-      printf("  test_addrbus KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
-      printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
+      test_printf("  test_addrbus KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
+      test_printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
       return 4;
     }
   }
 
   *(addr + testoffset) = pattern;
+  test_stats_add(sizeof(unsigned long), 0);
 
   /* Check for address bits stuck low or shorted. */
   for (testoffset = 1U;
@@ -427,10 +1109,11 @@ uint32_t DDR_Test_AddressBus(unsigned long size_in, unsigned long addr_in)
     *(addr + testoffset) = antipattern;
 
     data = *addr;
-    if (data != pattern)
+    test_stats_add(sizeof(unsigned long), sizeof(unsigned long));
+    if ((data != pattern) && test_error(addr, pattern, data))
     {
-      printf("  test_addrbus KO @ 0x%lx \n\r", (unsigned long)(addr + testoffset));
-      printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
+      test_printf("  test_addrbus KO @ 0x%lx \n\r", (unsigned long)(addr + testoffset));
+      test_printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
       return 5;
     }
 
@@ -440,15 +1123,18 @@ uint32_t DDR_Test_AddressBus(unsigned long size_in, unsigned long addr_in)
          offset <<= 1)
     {
      data = *(addr + offset);
-     if ((data != pattern) && (offset != testoffset))
+     test_stats_add(0, sizeof(unsigned long));
+     if ((data != pattern) && (offset != testoffset) &&
+         test_error(addr + offset, pattern, data))
       {
-        printf("  test_addrbus KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
-        printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
+        test_printf("  test_addrbus KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
+        test_printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
         return 6;
       }
     }
 
     *(addr + testoffset) = pattern;
+    test_stats_add(sizeof(unsigned long), 0);
   }
 
   return 0;
@@ -481,21 +1167,25 @@ uint32_t DDR_Test_MemDevice(unsigned long size_in, unsigned long addr_in)
   uintptr_t *addr = NULL;
   unsigned long size;
   unsigned long nb_words;
+  unsigned long nb_access;
   unsigned long offset;
   unsigned long pattern;
   unsigned long antipattern;
+  unsigned long data;
 
   if (get_buf_size(size_in, &size, 4 * 1024, 4) != 0)
   {
     return 1;
   }
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, size, &addr) != 0)
   {
     return 2;
   }
 
   nb_words = size / sizeof(unsigned long);
+  /* Every sizeof(unsigned long)th word of the region is accessed */
+  nb_access = (nb_words + sizeof(unsigned long) - 1) / sizeof(unsigned long);
 
   /* Fill memory with a known pattern. */
   for (pattern = 1, offset = 0; offset < nb_words;
@@ -503,32 +1193,38 @@ uint32_t DDR_Test_MemDevice(unsigned long size_in, unsigned long addr_in)
   {
     *(addr + offset) = pattern;
   }
+  test_stats_add(nb_access * sizeof(unsigned long), 0);
 
   /* Check each location and invert it for the second pass. */
   for (pattern = 1, offset = 0; offset < nb_words;
        pattern++, offset += sizeof(unsigned long))
   {
-    if (*(addr + offset) != pattern)
+    data = *(addr + offset);
+    if ((data != pattern) && test_error(addr + offset, pattern, data))
     {
-      printf("  test_memdevice KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
+      test_printf("  test_memdevice KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
       return 3;
     }
 
     antipattern = ~pattern;
     *(addr + offset) = antipattern;
   }
+  test_stats_add(nb_access * sizeof(unsigned long),
+                 nb_access * sizeof(unsigned long));
 
   /* Check each location for the inverted pattern and zero it. */
   for (pattern = 1, offset = 0; offset < nb_words;
        pattern++, offset += sizeof(unsigned long))
   {
     antipattern = ~pattern;
-    if (*(addr + offset) != antipattern)
+    data = *(addr + offset);
+    if ((data != antipattern) && test_error(addr + offset, antipattern, data))
     {
-      printf("  test_memdevice KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
+      test_printf("  test_memdevice KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
       return 4;
     }
   }
+  test_stats_add(0, nb_access * sizeof(unsigned long));
 
   return 0;
 }
@@ -571,13 +1267,14 @@ uint32_t DDR_Test_SimultaneousSwitchingOutput(unsigned long size_in,
   unsigned long remaining;
   unsigned long offset;
   unsigned long data = 0;
+  unsigned long read;
 
   if (get_buf_size(size_in, &size, 4 * 1024, 4) != 0)
   {
     return 1;
   }
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, size, &addr) != 0)
   {
     return 2;
   }
@@ -610,13 +1307,16 @@ uint32_t DDR_Test_SimultaneousSwitchingOutput(unsigned long size_in,
 
         *(addr + offset) = data;
 
-        if (*(addr + offset) != data)
+        read = *(addr + offset);
+        if ((read != data) && test_error(addr + offset, data, read))
         {
-          printf("  test_sso KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
+          test_printf("  test_sso KO @ 0x%lx \n\r", (unsigned long)(addr + offset));
           return 3;
         }
       }
     }
+    test_stats_add(sizeof(unsigned long) * 8 * 6 * sizeof(unsigned long),
+                   sizeof(unsigned long) * 8 * 6 * sizeof(unsigned long));
     offset ++;
     remaining -= sizeof(unsigned long);
   }
@@ -624,35 +1324,249 @@ uint32_t DDR_Test_SimultaneousSwitchingOutput(unsigned long size_in,
   return 0;
 }
 
-static void do_noise(unsigned long addr, unsigned long pattern,
-                     unsigned long *result)
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+/* NEON kernels: one 64-byte line = 8 words = 4 Q registers per iteration */
+#define DDR_NEON_LINE        64
+#define DDR_NEON_LINE_WORDS  (DDR_NEON_LINE / sizeof(unsigned long))
+
+static bool neon_usable(const uintptr_t *addr, unsigned long size)
+{
+  return (size != 0U) &&
+         ((((unsigned long)addr | size) & (DDR_NEON_LINE - 1)) == 0U);
+}
+
+/* fill size bytes (multiple of 64) with the 64-byte pattern */
+static void neon_fill(unsigned long addr, const unsigned long *pattern,
+                      unsigned long size)
 {
   __asm volatile (
-//                "PUSH {x2-x10}            \n"
-                  "STP x2, x3, [sp, #-16]!  \n"
-                  "STP x4, x5, [sp, #-16]!  \n"
-                  "STP x6, x7, [sp, #-16]!  \n"
-                  "STP x8, x9, [sp, #-16]!  \n"
-                  "STP x10, x11, [sp, #-16]!\n"
+                  "LD1 {v0.2d, v1.2d, v2.2d, v3.2d}, [%[pattern]] \n"
+
+                  "1:                                            \n"
+                  "STP q0, q1, [%[addr]], #32                    \n"
+                  "STP q2, q3, [%[addr]], #32                    \n"
+                  "SUBS %[size], %[size], #64                    \n"
+                  "B.NE 1b                                       \n"
+                  : [addr]    "+r" (addr),
+                    [size]    "+r" (size)
+                  : [pattern] "r" (pattern)
+                  : "v0", "v1", "v2", "v3", "cc", "memory");
+}
 
-                  "MOV x0, %[addr]          \n"
-                  "MOV x1, %[pattern]       \n"
-                  "MOV x12, %[result]       \n"
+/*
+ * compare size bytes (multiple of 64) with the reference, which is a 64-byte
+ * pattern (ref_inc = 0) or a buffer (ref_inc = 64). The mismatch of a line is
+ * reduced without branch (EOR, ORR, UMAXV): one exit test per line.
+ * Return the offset of the first failing line, whose words are stored in
+ * line[], or size when all lines match.
+ */
+static unsigned long neon_compare(unsigned long addr, unsigned long ref,
+                                  unsigned long ref_inc, unsigned long size,
+                                  unsigned long *line)
+{
+  unsigned long ptr = addr;
+  unsigned long remaining = size;
+  uint32_t diff;
 
-                  "MVN x2, x1               \n"
+  __asm volatile (
+                  "1:                                            \n"
+                  "LD1 {v0.2d, v1.2d, v2.2d, v3.2d}, [%[ref]], %[inc] \n"
+                  "LDP q4, q5, [%[ptr]], #32                     \n"
+                  "LDP q6, q7, [%[ptr]], #32                     \n"
+                  "EOR v16.16b, v4.16b, v0.16b                   \n"
+                  "EOR v17.16b, v5.16b, v1.16b                   \n"
+                  "EOR v18.16b, v6.16b, v2.16b                   \n"
+                  "EOR v19.16b, v7.16b, v3.16b                   \n"
+                  "ORR v16.16b, v16.16b, v17.16b                 \n"
+                  "ORR v18.16b, v18.16b, v19.16b                 \n"
+                  "ORR v16.16b, v16.16b, v18.16b                 \n"
+                  "UMAXV s16, v16.4s                             \n"
+                  "FMOV %w[diff], s16                            \n"
+                  "CBNZ %w[diff], 2f                             \n"
+                  "SUBS %[remaining], %[remaining], #64          \n"
+                  "B.NE 1b                                       \n"
+                  "B 3f                                          \n"
+
+                  "2:                                            \n"
+                  "ST1 {v4.2d, v5.2d, v6.2d, v7.2d}, [%[line]]   \n"
+                  "3:                                            \n"
+                  : [ptr]       "+r" (ptr),
+                    [ref]       "+r" (ref),
+                    [remaining] "+r" (remaining),
+                    [diff]      "=&r" (diff)
+                  : [inc]       "r" (ref_inc),
+                    [line]      "r" (line)
+                  : "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7",
+                    "v16", "v17", "v18", "v19", "cc", "memory");
+
+  if (diff == 0U)
+  {
+    return size;
+  }
+
+  return ptr - addr - DDR_NEON_LINE;
+}
 
-                  "STR x1, [x0]             \n"
-                  "LDR x3, [x0]             \n"
-                  "STR x2, [x0]             \n"
-                  "LDR x4, [x0]             \n"
+/*
+ * verify size bytes (multiple of 64) against the reference (see
+ * neon_compare), the failing lines are checked word per word.
+ * Return NULL when no mismatch stops the test, else the failing address
+ * with the expected and read data.
+ */
+static uintptr_t *neon_verify(uintptr_t *addr, const unsigned long *ref,
+                              unsigned long ref_inc, unsigned long size,
+                              unsigned long *expected, unsigned long *data)
+{
+  unsigned long line[DDR_NEON_LINE_WORDS];
+  const unsigned long *ref_line;
+  unsigned long offset = 0;
+  unsigned long j;
+
+  while (offset < size)
+  {
+    ref_line = (const unsigned long *)((unsigned long)ref +
+                                       (ref_inc != 0U ? offset : 0U));
+    offset += neon_compare((unsigned long)addr + offset,
+                           (unsigned long)ref_line, ref_inc, size - offset,
+                           line);
+    if (offset >= size)
+    {
+      break;
+    }
 
-                  "STR x1, [x0]             \n"
-                  "LDR x5, [x0]             \n"
-                  "STR x2, [x0]             \n"
-                  "LDR x6, [x0]             \n"
+    if (ref_inc != 0U)
+    {
+      ref_line = (const unsigned long *)((unsigned long)ref + offset);
+    }
 
-                  "STR x1, [x0]             \n"
-                  "LDR x7, [x0]             \n"
+    for (j = 0; j < DDR_NEON_LINE_WORDS; j++)
+    {
+      uintptr_t *word = (uintptr_t *)((unsigned long)addr + offset) + j;
+
+      if ((line[j] != ref_line[j]) && test_error(word, ref_line[j], line[j]))
+      {
+        *expected = ref_line[j];
+        *data = line[j];
+        return word;
+      }
+    }
+
+    offset += DDR_NEON_LINE;
+  }
+
+  return NULL;
+}
+
+/* fill size bytes (multiple of 64) from the 2 lane states, updated */
+static void neon_prng_fill(unsigned long addr, uint64_t *state,
+                           unsigned long size)
+{
+  __asm volatile (
+                  "LD1 {v0.2d}, [%[state]]                       \n"
+
+                  "1:                                            \n"
+                  "SHL v1.2d, v0.2d, #13                         \n"
+                  "EOR v0.16b, v0.16b, v1.16b                    \n"
+                  "USHR v1.2d, v0.2d, #7                         \n"
+                  "EOR v0.16b, v0.16b, v1.16b                    \n"
+                  "SHL v1.2d, v0.2d, #17                         \n"
+                  "EOR v2.16b, v0.16b, v1.16b                    \n"
+                  "SHL v1.2d, v2.2d, #13                         \n"
+                  "EOR v0.16b, v2.16b, v1.16b                    \n"
+                  "USHR v1.2d, v0.2d, #7                         \n"
+                  "EOR v0.16b, v0.16b, v1.16b                    \n"
+                  "SHL v1.2d, v0.2d, #17                         \n"
+                  "EOR v3.16b, v0.16b, v1.16b                    \n"
+                  "SHL v1.2d, v3.2d, #13                         \n"
+                  "EOR v0.16b, v3.16b, v1.16b                    \n"
+                  "USHR v1.2d, v0.2d, #7                         \n"
+                  "EOR v0.16b, v0.16b, v1.16b                    \n"
+                  "SHL v1.2d, v0.2d, #17                         \n"
+                  "EOR v4.16b, v0.16b, v1.16b                    \n"
+                  "SHL v1.2d, v4.2d, #13                         \n"
+                  "EOR v0.16b, v4.16b, v1.16b                    \n"
+                  "USHR v1.2d, v0.2d, #7                         \n"
+                  "EOR v0.16b, v0.16b, v1.16b                    \n"
+                  "SHL v1.2d, v0.2d, #17                         \n"
+                  "EOR v0.16b, v0.16b, v1.16b                    \n"
+                  "STP q2, q3, [%[addr]], #32                    \n"
+                  "STP q4, q0, [%[addr]], #32                    \n"
+                  "SUBS %[size], %[size], #64                    \n"
+                  "B.NE 1b                                       \n"
+
+                  "ST1 {v0.2d}, [%[state]]                       \n"
+                  : [addr]  "+r" (addr),
+                    [size]  "+r" (size)
+                  : [state] "r" (state)
+                  : "v0", "v1", "v2", "v3", "v4", "cc", "memory");
+}
+#endif /* __AARCH64__ && TEST_NEON_ENABLE */
+
+/* fill words words with the pseudo random sequence of the seed */
+static void prng_fill(uintptr_t *addr, uint64_t seed, unsigned long words)
+{
+  uint64_t state[DDR_PRNG_LANES];
+  unsigned long chunk;
+  unsigned long offset;
+  unsigned long nb;
+  unsigned long i;
+
+  for (offset = 0, chunk = 0; offset < words; offset += nb, chunk++)
+  {
+    nb = words - offset;
+    if (nb > DDR_PRNG_CHUNK_WORDS)
+    {
+      nb = DDR_PRNG_CHUNK_WORDS;
+    }
+
+    prng_chunk(seed, chunk, state);
+
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+    if (neon_usable(addr + offset, nb * sizeof(unsigned long)))
+    {
+      neon_prng_fill((unsigned long)(addr + offset), state,
+                     nb * sizeof(unsigned long));
+      continue;
+    }
+#endif
+
+    for (i = 0; i < nb; i++)
+    {
+      addr[offset + i] = prng_next(&state[i & (DDR_PRNG_LANES - 1)]);
+    }
+  }
+}
+
+static void do_noise(unsigned long addr, unsigned long pattern,
+                     unsigned long *result)
+{
+#ifdef __AARCH64__
+  __asm volatile (
+//                "PUSH {x2-x10}            \n"
+                  "STP x2, x3, [sp, #-16]!  \n"
+                  "STP x4, x5, [sp, #-16]!  \n"
+                  "STP x6, x7, [sp, #-16]!  \n"
+                  "STP x8, x9, [sp, #-16]!  \n"
+                  "STP x10, x11, [sp, #-16]!\n"
+
+                  "MOV x0, %[addr]          \n"
+                  "MOV x1, %[pattern]       \n"
+                  "MOV x12, %[result]       \n"
+
+                  "MVN x2, x1               \n"
+
+                  "STR x1, [x0]             \n"
+                  "LDR x3, [x0]             \n"
+                  "STR x2, [x0]             \n"
+                  "LDR x4, [x0]             \n"
+
+                  "STR x1, [x0]             \n"
+                  "LDR x5, [x0]             \n"
+                  "STR x2, [x0]             \n"
+                  "LDR x6, [x0]             \n"
+
+                  "STR x1, [x0]             \n"
+                  "LDR x7, [x0]             \n"
                   "STR x2, [x0]             \n"
                   "LDR x8, [x0]             \n"
 
@@ -677,6 +1591,19 @@ static void do_noise(unsigned long addr, unsigned long pattern,
                     [pattern] "r" (pattern),
                     [result]  "r" (result)
                   : "x0", "x1", "x12");
+#else
+  volatile unsigned long *ptr = (volatile unsigned long *)addr;
+  unsigned long antipattern = ~pattern;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+  {
+    *ptr = pattern;
+    result[i] = *ptr;
+    *ptr = antipattern;
+    result[i + 1] = *ptr;
+  }
+#endif
 }
 
 
@@ -717,18 +1644,21 @@ uint32_t DDR_Test_Noise(unsigned long pattern_in, unsigned long addr_in)
   }
 
   do_noise((unsigned long)addr, pattern, result);
+  test_stats_add(8 * sizeof(unsigned long), 8 * sizeof(unsigned long));
 
   for (i = 0; i < 8;)
   {
-    if (*(&result[i++]) != pattern)
+    if ((*(&result[i++]) != pattern) &&
+        test_error(addr, pattern, result[i - 1]))
     {
-      printf("  test_noise KO @ 0x%lx \n\r", result[i - 1]);
+      test_printf("  test_noise KO @ 0x%lx \n\r", result[i - 1]);
       return 2;
     }
 
-    if (*(&result[i++]) != ~pattern)
+    if ((*(&result[i++]) != ~pattern) &&
+        test_error(addr, ~pattern, result[i - 1]))
     {
-      printf("  test_noise KO @ 0x%lx \n\r", result[i - 1]);
+      test_printf("  test_noise KO @ 0x%lx \n\r", result[i - 1]);
       return 3;
     }
   }
@@ -739,6 +1669,7 @@ uint32_t DDR_Test_Noise(unsigned long pattern_in, unsigned long addr_in)
 static void do_noiseburst(unsigned long addr, unsigned long pattern,
                           unsigned long bufsize)
 {
+#ifdef __AARCH64__
   __asm volatile (
 //                "PUSH {x2-x8}             \n"
                   "STP x2, x3, [sp, #-16]!  \n"
@@ -796,6 +1727,24 @@ static void do_noiseburst(unsigned long addr, unsigned long pattern,
                     [pattern] "r" (pattern),
                     [bufsize] "r" (bufsize)
                   : "x0", "x1", "x10");
+#else
+  volatile unsigned long *ptr = (volatile unsigned long *)addr;
+  unsigned long antipattern = ~pattern;
+  unsigned long i;
+
+  /* 16 words per iteration, as one STMIA x1-x8 pair of the asm loop */
+  for (i = 0; i < bufsize / sizeof(unsigned long); i += 16, ptr += 16)
+  {
+    ptr[0] = pattern;  ptr[1] = antipattern;
+    ptr[2] = pattern;  ptr[3] = antipattern;
+    ptr[4] = pattern;  ptr[5] = antipattern;
+    ptr[6] = pattern;  ptr[7] = antipattern;
+    ptr[8] = pattern;  ptr[9] = antipattern;
+    ptr[10] = pattern; ptr[11] = antipattern;
+    ptr[12] = pattern; ptr[13] = antipattern;
+    ptr[14] = pattern; ptr[15] = antipattern;
+  }
+#endif
 }
 
 #define DDR_CHUNK_SIZE  0x08000000
@@ -832,6 +1781,12 @@ uint32_t DDR_Test_NoiseBurst(unsigned long size_in, unsigned long pattern_in,
   unsigned long remaining;
   unsigned long size;
   unsigned long i;
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+  unsigned long line[DDR_NEON_LINE_WORDS];
+  unsigned long expected;
+  uintptr_t *fail;
+  bool neon;
+#endif
 
   if (get_buf_size(size_in, &bufsize, 4 * 1024, 128) != 0)
   {
@@ -840,11 +1795,19 @@ uint32_t DDR_Test_NoiseBurst(unsigned long size_in, unsigned long pattern_in,
 
   get_pattern(pattern_in, &pattern, 0xFFFFFFFF);
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, bufsize, &addr) != 0)
   {
     return 2;
   }
 
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+  neon = neon_usable(addr, bufsize);
+  for (i = 0; i < DDR_NEON_LINE_WORDS; i++)
+  {
+    line[i] = (i & 1U) ? ~pattern : pattern;
+  }
+#endif
+
   offset = 0;
   remaining = bufsize;
   size = DDR_CHUNK_SIZE;
@@ -856,28 +1819,55 @@ uint32_t DDR_Test_NoiseBurst(unsigned long size_in, unsigned long pattern_in,
       size = remaining;
     }
 
-    do_noiseburst((unsigned long)(addr + offset), pattern, size);
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+    if (neon)
+    {
+      neon_fill((unsigned long)addr + offset, line, size);
+    }
+    else
+#endif
+    {
+      do_noiseburst((unsigned long)addr + offset, pattern, size);
+    }
+    test_stats_add(size, 0);
     remaining -= size;
     offset += size;
   }
 
+  test_stats_add(0, bufsize);
+
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+  if (neon)
+  {
+    fail = neon_verify(addr, line, 0, bufsize, &expected, &data);
+    if (fail != NULL)
+    {
+      test_printf("  test_noiseburst KO @ 0x%lx\n\r", (unsigned long)fail);
+      test_printf("  read 0x%lx instead of 0x%lx\n\r", data, expected);
+      return ((fail - addr) & 1) ? 4 : 3;
+    }
+
+    return 0;
+  }
+#endif
+
   for (i = 0; i < bufsize / sizeof(unsigned long);)
   {
     data = *(addr + i);
-    if (data != pattern)
+    if ((data != pattern) && test_error(addr + i, pattern, data))
     {
-      printf("  test_noiseburst KO @ 0x%lx\n\r", (unsigned long)(addr + i));
-      printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
+      test_printf("  test_noiseburst KO @ 0x%lx\n\r", (unsigned long)(addr + i));
+      test_printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
       return 3;
     }
 
     i++;
 
     data = *(addr + i);
-    if (data != ~pattern)
+    if ((data != ~pattern) && test_error(addr + i, ~pattern, data))
     {
-      printf("  test_noiseburst KO @ 0x%lx\n\r", (unsigned long)(addr + i));
-      printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
+      test_printf("  test_noiseburst KO @ 0x%lx\n\r", (unsigned long)(addr + i));
+      test_printf("  read 0x%lx instead of 0x%lx\n\r", data, pattern);
       return 4;
     }
 
@@ -921,7 +1911,16 @@ uint32_t DDR_Test_Random(unsigned long size_in, unsigned long loop_in,
   uint32_t nb_loop;
   unsigned long bufsize_bytes;
   unsigned long bufsize_words;
-  unsigned int seed;
+  unsigned long verify_words;
+  unsigned long i;
+  uint64_t base_seed;
+  uint64_t seed;
+  uint64_t state[DDR_PRNG_LANES];
+  unsigned int core;
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+  uintptr_t *fail;
+  bool neon;
+#endif
 
   if (get_buf_size(size_in, &bufsize_bytes, 4 * 1024, 8) != 0)
   {
@@ -930,46 +1929,86 @@ uint32_t DDR_Test_Random(unsigned long size_in, unsigned long loop_in,
 
   get_nb_loop(loop_in, &nb_loop, 10);
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, bufsize_bytes, &addr) != 0)
   {
     return 2;
   }
 
-  bufsize_bytes /= 2;
-  bufsize_words = bufsize_bytes/sizeof(unsigned long);
+  /* 2 regions of whole words: the 2nd one is a copy of the 1st one */
+  bufsize_words = bufsize_bytes / (2 * sizeof(unsigned long));
+  bufsize_bytes = bufsize_words * sizeof(unsigned long);
+  verify_words = 2 * bufsize_words;
+
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+  /* the copy is compared with the 1st region by NEON, not regenerated */
+  neon = neon_usable(addr, bufsize_bytes);
+  if (neon)
+  {
+    verify_words = bufsize_words;
+  }
+#endif
+
+  /*
+   * the seed of each loop is derived from the seed of the test; in smp, each
+   * core prints its own seed, which replays its half of the buffer alone
+   */
+  if (smp_seed != 0U)
+  {
+    core = get_core_id();
+    base_seed = smp_seed + (core * DDR_PRNG_GAMMA);
+    test_printf("  seed 0x%lx (A35_%u)\n\r", (unsigned long)base_seed, core);
+  }
+  else
+  {
+    base_seed = prng_seed();
+    test_printf("  seed 0x%lx\n\r", (unsigned long)base_seed);
+  }
+  base_seed = prng_mix(base_seed);
 
   while (error == 0U)
   {
-    seed = rand();
-    srand(seed);
+    seed = prng_mix(base_seed + (loop * DDR_PRNG_GAMMA));
 
-    for (offset = 0; offset < bufsize_words; offset ++)
-    {
-      data = rand();
-      *(addr + offset) = data;
-    }
+    prng_fill(addr, seed, bufsize_words);
 
     memcpy((void *)((unsigned long)addr + bufsize_bytes), addr, bufsize_bytes);
+    test_stats_add(2 * bufsize_bytes, bufsize_bytes);
 
-    srand(seed);
-
-    for (offset = 0; offset < (2 * bufsize_words); offset ++)
+    /* the copy is checked against the same sequence, chunk per chunk */
+    for (offset = 0; offset < verify_words; offset ++)
     {
-      if (offset == bufsize_words)
+      i = (offset < bufsize_words) ? offset : offset - bufsize_words;
+      if ((i & (DDR_PRNG_CHUNK_WORDS - 1)) == 0U)
       {
-        srand(seed);
+        prng_chunk(seed, i / DDR_PRNG_CHUNK_WORDS, state);
       }
 
-      value = rand();
+      value = prng_next(&state[i & (DDR_PRNG_LANES - 1)]);
       data = *(addr + offset);
-      if (data != value)
+      if ((data != value) && test_error(addr + offset, value, data))
       {
         error++;
-        printf("  loop %d: error @ 0x%lx: 0x%lx expected 0x%lx\n\r",
-               loop, (unsigned long)(addr + offset), data, value);
+        test_printf("  loop %d: error @ 0x%lx: 0x%lx expected 0x%lx\n\r",
+                    loop, (unsigned long)(addr + offset), data, value);
         break;
       }
     }
+    test_stats_add(0, offset * sizeof(unsigned long));
+
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+    if (neon && (error == 0U))
+    {
+      fail = neon_verify(addr + bufsize_words, addr, DDR_NEON_LINE,
+                         bufsize_bytes, &value, &data);
+      test_stats_add(0, 2 * bufsize_bytes);
+      if (fail != NULL)
+      {
+        error++;
+        test_printf("  loop %d: error @ 0x%lx: 0x%lx expected 0x%lx\n\r",
+                    loop, (unsigned long)fail, data, value);
+      }
+    }
+#endif
 
     if (test_loop_end(&loop, nb_loop))
     {
@@ -979,7 +2018,7 @@ uint32_t DDR_Test_Random(unsigned long size_in, unsigned long loop_in,
 
   if (error != 0U)
   {
-    printf("  test_random KO\n\r");
+    test_printf("  test_random KO\n\r");
     return 3;
   }
 
@@ -992,6 +2031,7 @@ uint32_t DDR_Test_Random(unsigned long size_in, unsigned long loop_in,
 static void test_loop_in(const unsigned long *pattern, unsigned long offset,
                          unsigned long testsize)
 {
+#ifdef __AARCH64__
   __asm volatile (
 //                "PUSH {x3-x10}            \n"
                   "STP x3, x4, [sp, #-16]!  \n"
@@ -1047,6 +2087,20 @@ static void test_loop_in(const unsigned long *pattern, unsigned long offset,
                       [offset]   "r" (offset),
                       [testsize] "r" (testsize)
                     : "x0", "x1", "x2");
+#else
+  volatile unsigned long *ptr = (volatile unsigned long *)offset;
+  unsigned long p0 = pattern[0], p1 = pattern[1], p2 = pattern[2];
+  unsigned long p3 = pattern[3], p4 = pattern[4], p5 = pattern[5];
+  unsigned long p6 = pattern[6], p7 = pattern[7];
+  unsigned long i;
+
+  for (i = 0; i < testsize / sizeof(unsigned long);
+       i += DDR_PATTERN_SIZE, ptr += DDR_PATTERN_SIZE)
+  {
+    ptr[0] = p0; ptr[1] = p1; ptr[2] = p2; ptr[3] = p3;
+    ptr[4] = p4; ptr[5] = p5; ptr[6] = p6; ptr[7] = p7;
+  }
+#endif
 }
 
 static int test_loop(const unsigned long *pattern, uintptr_t *address,
@@ -1057,19 +2111,41 @@ static int test_loop(const unsigned long *pattern, uintptr_t *address,
   unsigned long offset;
   unsigned long testsize;
   unsigned long remaining;
+  unsigned long data;
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+  uintptr_t *fail;
+  unsigned long expected;
+
+  if (neon_usable(address, bufsize))
+  {
+    /* DDR_PATTERN_SIZE is one NEON line: the pattern is the reference */
+    neon_fill((unsigned long)address, pattern, bufsize);
+    test_stats_add(bufsize, 0);
+    fail = neon_verify(address, pattern, 0, bufsize, &expected, &data);
+    test_stats_add(0, bufsize);
+    if (fail != NULL)
+    {
+      test_printf("  test_freqpattern KO @ 0x%lx\n\r", (unsigned long)fail);
+      return 1;
+    }
+
+    return 0;
+  }
+#endif
 
   offset = (unsigned long)address;
   remaining = bufsize;
 
   while (remaining)
   {
-    testsize = bufsize > 0x1000000 ? 0x1000000 : bufsize;
+    testsize = remaining > 0x1000000 ? 0x1000000 : remaining;
 
     test_loop_in(pattern, offset, testsize);
 
     offset += testsize;
     remaining -= testsize;
   }
+  test_stats_add(bufsize, 0);
 
   offset = 0;
 
@@ -1077,13 +2153,16 @@ static int test_loop(const unsigned long *pattern, uintptr_t *address,
   {
     for (j = 0; j < DDR_PATTERN_SIZE; j++, offset++)
     {
-      if (*(address + offset) != pattern[j])
+      data = *(address + offset);
+      if ((data != pattern[j]) &&
+          test_error(address + offset, pattern[j], data))
       {
-        printf("  test_freqpattern KO @ 0x%lx\n\r", (unsigned long)(address + offset));
+        test_printf("  test_freqpattern KO @ 0x%lx\n\r", (unsigned long)(address + offset));
         return 1;
       }
     }
   }
+  test_stats_add(0, bufsize);
 
   return 0;
 }
@@ -1129,8 +2208,6 @@ const unsigned long pattern_mostly_one_x32[DDR_PATTERN_SIZE] = {
 };
 
 #define DDR_NB_PATTERN                      5
-#define DDRCTRL_MSTR_DATA_BUS_WIDTH_HALF    DDRC_MSTR_DATA_BUS_WIDTH_0
-#define DDRCTRL_MSTR_DATA_BUS_WIDTH_QUARTER DDRC_MSTR_DATA_BUS_WIDTH_1
 
 /**
 * @brief test_freqpattern.
@@ -1184,21 +2261,12 @@ uint32_t DDR_Test_FrequencySelectivePattern(unsigned long size,
     return 1;
   }
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, bufsize, &addr) != 0)
   {
     return 2;
   }
 
-  switch (READ_REG(DDRC->MSTR) & DDRC_MSTR_DATA_BUS_WIDTH_Msk)
-  {
-    case DDRCTRL_MSTR_DATA_BUS_WIDTH_HALF:
-    case DDRCTRL_MSTR_DATA_BUS_WIDTH_QUARTER:
-      bus_width = 16;
-      break;
-    default:
-      bus_width = 32;
-      break;
-  }
+  bus_width = get_bus_width();
 
   patterns = (const unsigned long **)(bus_width == 16 ? patterns_x16 : patterns_x32);
 
@@ -1207,7 +2275,7 @@ uint32_t DDR_Test_FrequencySelectivePattern(unsigned long size,
     ret = test_loop(patterns[i], addr, bufsize);
     if (ret != 0)
     {
-      printf("  test_freqpattern KO\n\r");
+      test_printf("  test_freqpattern KO\n\r");
       return 3;
     }
   }
@@ -1222,7 +2290,33 @@ static int test_loop_size(const unsigned long *pattern, unsigned long size,
                           __attribute__((unused))uint32_t loop)
 {
   unsigned long i, j;
+  unsigned long data;
   uintptr_t *addr = (uintptr_t *)address;
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+  unsigned long line[DDR_NEON_LINE_WORDS];
+  unsigned long expected;
+  uintptr_t *fail;
+
+  if (neon_usable(address, bufsize) && ((DDR_NEON_LINE_WORDS % size) == 0U))
+  {
+    for (j = 0; j < DDR_NEON_LINE_WORDS; j++)
+    {
+      line[j] = pattern[j % size];
+    }
+
+    neon_fill((unsigned long)address, line, bufsize);
+    test_stats_add(bufsize, 0);
+    fail = neon_verify(address, line, 0, bufsize, &expected, &data);
+    test_stats_add(0, bufsize);
+    if (fail != NULL)
+    {
+      test_printf("  test KO @ 0x%lx\n\r", (unsigned long)fail);
+      return 1;
+    }
+
+    return 0;
+  }
+#endif
 
   for (i = 0; i < bufsize / sizeof(unsigned long); i += size)
   {
@@ -1232,19 +2326,22 @@ static int test_loop_size(const unsigned long *pattern, unsigned long size,
     }
 
   }
+  test_stats_add(bufsize, 0);
 
   addr = address;
   for (i = 0; i < bufsize / sizeof(unsigned long); i += size)
   {
     for (j = 0; j < size; j++, addr++)
     {
-      if (*addr != pattern[j])
+      data = *addr;
+      if ((data != pattern[j]) && test_error(addr, pattern[j], data))
       {
-        printf("  test KO @ 0x%lx\n\r", (unsigned long)addr);
+        test_printf("  test KO @ 0x%lx\n\r", (unsigned long)addr);
         return 1;
       }
     }
   }
+  test_stats_add(0, bufsize);
 
   return 0;
 }
@@ -1287,7 +2384,7 @@ uint32_t DDR_Test_BlockSequential(unsigned long size, unsigned long loop_in,
 
   get_nb_loop(loop_in, &nb_loop, 1);
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, bufsize, &addr) != 0)
   {
     return 2;
   }
@@ -1300,7 +2397,7 @@ uint32_t DDR_Test_BlockSequential(unsigned long size, unsigned long loop_in,
       ret = test_loop_size(&value, 1, addr, bufsize, 256, i);
       if (ret != 0)
       {
-        printf("  test_blockseq KO\n\r");
+        test_printf("  test_blockseq KO\n\r");
         return 3;
       }
     }
@@ -1355,7 +2452,7 @@ uint32_t DDR_Test_Checkerboard(unsigned long size, unsigned long loop_in,
 
   get_nb_loop(loop_in, &nb_loop, 1);
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, bufsize, &addr) != 0)
   {
     return 2;
   }
@@ -1367,7 +2464,7 @@ uint32_t DDR_Test_Checkerboard(unsigned long size, unsigned long loop_in,
       ret = test_loop_size(checkboard, 2, addr, bufsize, 2, i);
       if (ret != 0)
       {
-        printf("  test_checkboard KO\n\r");
+        test_printf("  test_checkboard KO\n\r");
         return 3;
       }
 
@@ -1424,7 +2521,7 @@ uint32_t DDR_Test_BitSpread(unsigned long size, unsigned long loop_in,
 
   get_nb_loop(loop_in, &nb_loop, 1);
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, bufsize, &addr) != 0)
   {
     return 2;
   }
@@ -1451,7 +2548,7 @@ uint32_t DDR_Test_BitSpread(unsigned long size, unsigned long loop_in,
         ret = test_loop_size(bitspread, 4, addr, bufsize, 32, i);
         if (ret != 0)
         {
-          printf("  test_bitspread KO\n\r");
+          test_printf("  test_bitspread KO\n\r");
           return 3;
         }
       }
@@ -1503,7 +2600,7 @@ uint32_t DDR_Test_BitFlip(unsigned long size, unsigned long loop_in,
 
   get_nb_loop(loop_in, &nb_loop, 1);
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, bufsize, &addr) != 0)
   {
     return 2;
   }
@@ -1520,7 +2617,7 @@ uint32_t DDR_Test_BitFlip(unsigned long size, unsigned long loop_in,
       ret = test_loop_size(bitflip, 4, addr, bufsize, 32, i);
       if (ret != 0)
       {
-        printf("  test_bitflip KO\n\r");
+        test_printf("  test_bitflip KO\n\r");
         return 3;
       }
     }
@@ -1572,7 +2669,7 @@ uint32_t DDR_Test_WalkingZeroes(unsigned long size, unsigned long loop_in,
 
   get_nb_loop(loop_in, &nb_loop, 1);
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, bufsize, &addr) != 0)
   {
     return 2;
   }
@@ -1595,7 +2692,7 @@ uint32_t DDR_Test_WalkingZeroes(unsigned long size, unsigned long loop_in,
       ret = test_loop_size(&value, 1, addr, bufsize, (depth * 2) -1, i);
       if (ret != 0)
       {
-        printf("  test_walkbit0 KO\n\r");
+        test_printf("  test_walkbit0 KO\n\r");
         return 3;
       }
     }
@@ -1647,7 +2744,7 @@ uint32_t DDR_Test_WalkingOnes(unsigned long size, unsigned long loop_in,
 
   get_nb_loop(loop_in, &nb_loop, 1);
 
-  if (get_addr(addr_in, &addr) != 0)
+  if (get_range(addr_in, bufsize, &addr) != 0)
   {
     return 2;
   }
@@ -1670,7 +2767,7 @@ uint32_t DDR_Test_WalkingOnes(unsigned long size, unsigned long loop_in,
       ret = test_loop_size(&value, 1, addr, bufsize, (depth * 2) - 1, i);
       if (ret != 0)
       {
-        printf("  test_walkbit1 KO\n\r");
+        test_printf("  test_walkbit1 KO\n\r");
         return 3;
       }
     }
@@ -1684,6 +2781,1149 @@ uint32_t DDR_Test_WalkingOnes(unsigned long size, unsigned long loop_in,
   return 0;
 }
 
+/**
+* @brief test_cacheline.
+* @par Test Description
+*   Cache Line Test.
+*   Each 64-byte line is allocated with DC ZVA (no read), written with its
+*   address (inverted on odd loops) then evicted with DC CIVAC; the read
+*   pass refetches and evicts each line. With the DDR mapped cacheable, the
+*   DDR sees only full-line bursts; with the non-cacheable mapping, the
+*   same accesses are single beats.
+* @par Test Hardware Connection
+* - None
+* @par Required preconditions
+* - Address aligned on 64 bytes
+* @par Expected result
+* - None
+* @par Called functions
+* - None
+* @par Used Peripherals
+* - None,...
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*  None(0xFF): if the result is deduced by the user: waveform, event...
+*/
+uint32_t DDR_Test_CacheLine(unsigned long size, unsigned long loop_in,
+                            unsigned long addr_in)
+{
+  unsigned long bufsize;
+  uint32_t nb_loop;
+  uint32_t loop = 0;
+  uintptr_t *addr = NULL;
+  uintptr_t *line;
+  unsigned long offset;
+  unsigned long pattern;
+  unsigned long value;
+  unsigned long data;
+  unsigned long i;
+  bool zero;
+
+  if (get_buf_size(size, &bufsize, 4 * 1024, DDR_CACHE_LINE) != 0)
+  {
+    return 1;
+  }
+
+  get_nb_loop(loop_in, &nb_loop, 1);
+
+  if (get_range(addr_in, bufsize, &addr) != 0)
+  {
+    return 2;
+  }
+
+  if (((unsigned long)addr & (DDR_CACHE_LINE - 1)) != 0U)
+  {
+    test_printf("Unaligned address: 0x%lx (line=0x%x)\n\r", (unsigned long)addr,
+                DDR_CACHE_LINE);
+    return 2;
+  }
+
+  zero = cache_zero_usable();
+
+  while (1)
+  {
+    pattern = (loop & 1U) ? ~0UL : 0UL;
+
+    for (offset = 0; offset < bufsize; offset += DDR_CACHE_LINE)
+    {
+      line = (uintptr_t *)((unsigned long)addr + offset);
+      if (zero)
+      {
+        cache_zero(line);
+      }
+
+      for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+      {
+        line[i] = (unsigned long)&line[i] ^ pattern;
+      }
+
+      cache_clean_invalidate(line);
+    }
+    cache_sync();
+    test_stats_add(bufsize, 0);
+
+    for (offset = 0; offset < bufsize; offset += DDR_CACHE_LINE)
+    {
+      line = (uintptr_t *)((unsigned long)addr + offset);
+
+      for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+      {
+        value = (unsigned long)&line[i] ^ pattern;
+        data = line[i];
+        if ((data != value) && test_error(&line[i], value, data))
+        {
+          test_printf("  test_cacheline KO @ 0x%lx\n\r", (unsigned long)&line[i]);
+          test_printf("  read 0x%lx instead of 0x%lx\n\r", data, value);
+          return 3;
+        }
+      }
+
+      cache_clean_invalidate(line);
+    }
+    cache_sync();
+    test_stats_add(0, bufsize);
+
+    if (test_loop_end(&loop, nb_loop))
+    {
+      break;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * March algorithms: each element applies its operations in order on every
+ * 64-byte group (one DDR burst) of the range, in ascending or descending
+ * address order. The "0" data is the background of the loop and the "1"
+ * data its complement.
+ */
+#define MARCH_W              0x1U  /* write, else read */
+#define MARCH_1              0x2U  /* complement of the background */
+#define MARCH_R0             0x0U
+#define MARCH_R1             MARCH_1
+#define MARCH_W0             MARCH_W
+#define MARCH_W1             (MARCH_W | MARCH_1)
+#define MARCH_UP             0
+#define MARCH_DOWN           1
+#define MARCH_OP_MAX         5
+#define MARCH_ELEMENT_MAX    6
+
+typedef struct {
+  uint8_t dir;
+  uint8_t nb_op;
+  uint8_t op[MARCH_OP_MAX];
+} march_element;
+
+typedef struct {
+  const char *name;
+  uint8_t nb_element;
+  march_element element[MARCH_ELEMENT_MAX];
+} march_algo;
+
+/* {up(w0); up(r0,w1); up(r1,w0); down(r0,w1); down(r1,w0); up(r0)} */
+static const march_algo march_c_minus = {
+  "March C-", 6, {
+    {MARCH_UP,   1, {MARCH_W0}},
+    {MARCH_UP,   2, {MARCH_R0, MARCH_W1}},
+    {MARCH_UP,   2, {MARCH_R1, MARCH_W0}},
+    {MARCH_DOWN, 2, {MARCH_R0, MARCH_W1}},
+    {MARCH_DOWN, 2, {MARCH_R1, MARCH_W0}},
+    {MARCH_UP,   1, {MARCH_R0}},
+  }
+};
+
+/*
+ * {up(w0); up(r0,r0,w0,r0,w1); up(r1,r1,w1,r1,w0);
+ *  down(r0,r0,w0,r0,w1); down(r1,r1,w1,r1,w0); up(r0)}
+ */
+static const march_algo march_ss = {
+  "March SS", 6, {
+    {MARCH_UP,   1, {MARCH_W0}},
+    {MARCH_UP,   5, {MARCH_R0, MARCH_R0, MARCH_W0, MARCH_R0, MARCH_W1}},
+    {MARCH_UP,   5, {MARCH_R1, MARCH_R1, MARCH_W1, MARCH_R1, MARCH_W0}},
+    {MARCH_DOWN, 5, {MARCH_R0, MARCH_R0, MARCH_W0, MARCH_R0, MARCH_W1}},
+    {MARCH_DOWN, 5, {MARCH_R1, MARCH_R1, MARCH_W1, MARCH_R1, MARCH_W0}},
+    {MARCH_UP,   1, {MARCH_R0}},
+  }
+};
+
+/* {up(w0); up(r0,w1); down(r1,w0)} */
+static const march_algo march_mats_plus = {
+  "MATS+", 3, {
+    {MARCH_UP,   1, {MARCH_W0}},
+    {MARCH_UP,   2, {MARCH_R0, MARCH_W1}},
+    {MARCH_DOWN, 2, {MARCH_R1, MARCH_W0}},
+  }
+};
+
+/* data backgrounds of the loops, for the coupling faults inside a word */
+static const unsigned long march_background[] = {
+  0x0000000000000000UL,
+  0x5555555555555555UL,
+  0x3333333333333333UL,
+  0x0F0F0F0F0F0F0F0FUL,
+  0x00FF00FF00FF00FFUL,
+  0x0000FFFF0000FFFFUL,
+  0x00000000FFFFFFFFUL,
+};
+
+#define MARCH_BACKGROUND_NB  (sizeof(march_background) / \
+                              sizeof(march_background[0]))
+
+/* write the 64-byte group with 4 STP, as a single burst */
+static void march_write(uintptr_t *line, unsigned long value)
+{
+#ifdef __AARCH64__
+  __asm volatile (
+                  "STP %[value], %[value], [%[line]]      \n"
+                  "STP %[value], %[value], [%[line], #16] \n"
+                  "STP %[value], %[value], [%[line], #32] \n"
+                  "STP %[value], %[value], [%[line], #48] \n"
+                  :
+                  : [line]  "r" (line),
+                    [value] "r" (value)
+                  : "memory");
+#else
+  volatile unsigned long *ptr = (volatile unsigned long *)line;
+  unsigned int i;
+
+  for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+  {
+    ptr[i] = value;
+  }
+#endif
+}
+
+/*
+ * read the 64-byte group in data[] with 4 LDP issued back to back, return
+ * the bits which differ from value
+ */
+static unsigned long march_read(const uintptr_t *line, unsigned long value,
+                                unsigned long *data)
+{
+  unsigned long diff = 0;
+  unsigned int i;
+
+#ifdef __AARCH64__
+  __asm volatile (
+                  "LDP %[d0], %[d1], [%[line]]      \n"
+                  "LDP %[d2], %[d3], [%[line], #16] \n"
+                  "LDP %[d4], %[d5], [%[line], #32] \n"
+                  "LDP %[d6], %[d7], [%[line], #48] \n"
+                  : [d0] "=&r" (data[0]), [d1] "=&r" (data[1]),
+                    [d2] "=&r" (data[2]), [d3] "=&r" (data[3]),
+                    [d4] "=&r" (data[4]), [d5] "=&r" (data[5]),
+                    [d6] "=&r" (data[6]), [d7] "=&r" (data[7])
+                  : [line] "r" (line)
+                  : "memory");
+#else
+  const volatile unsigned long *ptr = (const volatile unsigned long *)line;
+
+  for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+  {
+    data[i] = ptr[i];
+  }
+#endif
+
+  for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+  {
+    diff |= data[i] ^ value;
+  }
+
+  return diff;
+}
+
+static int march_element_run(const march_algo *algo, unsigned int index,
+                             uintptr_t *addr, unsigned long bufsize,
+                             unsigned long background)
+{
+  const march_element *element = &algo->element[index];
+  unsigned long data[DDR_CACHE_LINE_WORDS];
+  unsigned long nb_line = bufsize / DDR_CACHE_LINE;
+  unsigned long nb_read = 0;
+  unsigned long value;
+  unsigned long n;
+  uintptr_t *line;
+  unsigned int op;
+  unsigned int i;
+
+  for (n = 0; n < nb_line; n++)
+  {
+    line = addr + (((element->dir == MARCH_DOWN) ? (nb_line - 1 - n) : n) *
+                   DDR_CACHE_LINE_WORDS);
+
+    for (op = 0; op < element->nb_op; op++)
+    {
+      value = ((element->op[op] & MARCH_1) != 0U) ? ~background : background;
+
+      if ((element->op[op] & MARCH_W) != 0U)
+      {
+        march_write(line, value);
+        continue;
+      }
+
+      if (march_read(line, value, data) == 0U)
+      {
+        continue;
+      }
+
+      for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+      {
+        if ((data[i] != value) && test_error(&line[i], value, data[i]))
+        {
+          test_printf("  %s KO @ 0x%lx (element %u, background 0x%lx)\n\r",
+                      algo->name, (unsigned long)&line[i], index, background);
+          test_printf("  read 0x%lx instead of 0x%lx\n\r", data[i], value);
+          return 1;
+        }
+      }
+    }
+  }
+
+  for (op = 0; op < element->nb_op; op++)
+  {
+    if ((element->op[op] & MARCH_W) == 0U)
+    {
+      nb_read++;
+    }
+  }
+  test_stats_add((element->nb_op - nb_read) * bufsize, nb_read * bufsize);
+
+  return 0;
+}
+
+static uint32_t march_test(const march_algo *algo, unsigned long size,
+                           unsigned long loop_in, unsigned long addr_in)
+{
+  unsigned long bufsize;
+  unsigned long background;
+  uint32_t nb_loop;
+  uint32_t loop = 0;
+  uintptr_t *addr = NULL;
+  unsigned int i;
+
+  if (get_buf_size(size, &bufsize, 4 * 1024, DDR_CACHE_LINE) != 0)
+  {
+    return 1;
+  }
+
+  get_nb_loop(loop_in, &nb_loop, 1);
+
+  if (get_range(addr_in, bufsize, &addr) != 0)
+  {
+    return 2;
+  }
+
+  if (((unsigned long)addr & (DDR_CACHE_LINE - 1)) != 0U)
+  {
+    test_printf("Unaligned address: 0x%lx (line=0x%x)\n\r", (unsigned long)addr,
+                DDR_CACHE_LINE);
+    return 2;
+  }
+
+  while (1)
+  {
+    background = march_background[loop % MARCH_BACKGROUND_NB];
+
+    for (i = 0; i < algo->nb_element; i++)
+    {
+      if (march_element_run(algo, i, addr, bufsize, background) != 0)
+      {
+        return 3;
+      }
+    }
+
+    if (test_loop_end(&loop, nb_loop))
+    {
+      break;
+    }
+  }
+
+  return 0;
+}
+
+/**
+* @brief test_marchcminus.
+* @par Test Description
+*   March C- algorithm (10n): detects the stuck-at, transition, address
+*   decoder and unlinked coupling faults.
+*   Each loop uses the next data background, the complement of the
+*   background is the "1" data.
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*/
+uint32_t DDR_Test_MarchCMinus(unsigned long size, unsigned long loop_in,
+                              unsigned long addr_in)
+{
+  return march_test(&march_c_minus, size, loop_in, addr_in);
+}
+
+/**
+* @brief test_marchss.
+* @par Test Description
+*   March SS algorithm (22n): adds the read destructive, deceptive read
+*   destructive and write disturb faults to the March C- coverage.
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*/
+uint32_t DDR_Test_MarchSS(unsigned long size, unsigned long loop_in,
+                          unsigned long addr_in)
+{
+  return march_test(&march_ss, size, loop_in, addr_in);
+}
+
+/**
+* @brief test_matsplus.
+* @par Test Description
+*   MATS+ algorithm (5n): quick detection of the stuck-at and address
+*   decoder faults.
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*/
+uint32_t DDR_Test_MatsPlus(unsigned long size, unsigned long loop_in,
+                           unsigned long addr_in)
+{
+  return march_test(&march_mats_plus, size, loop_in, addr_in);
+}
+
+/*
+ * Address map tests: the DDR is walked by bank, row and column from the
+ * address map of the DDRC. The tested rows start at the row of [addr] and
+ * each row is tested in all the banks of all the ranks.
+ */
+#define ADDRMAP_ORDER_BANK      0  /* all the rows of a bank, bank by bank */
+#define ADDRMAP_ORDER_ROW       1  /* the row of each bank, row by row */
+#define ADDRMAP_ORDER_CONFLICT  2  /* ping-pong between 2 rows of a bank */
+
+typedef struct {
+  const char *name;
+  int order;
+  unsigned long row_mask;
+  /* offset of the 1st value, mask and number of values of each loop level */
+  unsigned long first[3];
+  unsigned long mask[3];
+  unsigned long nb[3];
+} addrmap_walk;
+
+/* offset of a location from the DDR base */
+static unsigned long addrmap_offset(unsigned long rank, unsigned long bg,
+                                    unsigned long bank, unsigned long row,
+                                    unsigned long col)
+{
+  ddr_addrmap_loc loc = {rank, bg, bank, row, col};
+
+  return DDR_AddrMap_Encode(&loc) - (unsigned long)DDR_MEM_BASE;
+}
+
+/* next value of the bits of mask, spread in the address */
+static unsigned long addrmap_next(unsigned long offset, unsigned long mask)
+{
+  return ((offset | ~mask) + 1UL) & mask;
+}
+
+/* write or verify one word with its address xor pattern */
+static bool addrmap_access(const addrmap_walk *walk, uintptr_t *word,
+                           unsigned long pattern, bool write)
+{
+  unsigned long value = (unsigned long)word ^ pattern;
+  unsigned long data;
+
+  if (write)
+  {
+    *word = value;
+    return true;
+  }
+
+  data = *word;
+  if ((data != value) && test_error(word, value, data))
+  {
+    test_printf("  %s KO @ 0x%lx\n\r", walk->name, (unsigned long)word);
+    addrmap_print_loc("", (unsigned long)word);
+    test_printf("  read 0x%lx instead of 0x%lx\n\r", data, value);
+    return false;
+  }
+
+  return true;
+}
+
+static bool addrmap_pass(const addrmap_walk *walk, unsigned long pattern,
+                         bool write)
+{
+  unsigned long base = (unsigned long)DDR_MEM_BASE;
+  unsigned long off_a, off_b, off_c;
+  unsigned long row2 = 0;
+  unsigned long a, b, c;
+
+  off_a = walk->first[0];
+  for (a = 0; a < walk->nb[0]; a++)
+  {
+    off_b = walk->first[1];
+    for (b = 0; b < walk->nb[1]; b++)
+    {
+      if (walk->order == ADDRMAP_ORDER_CONFLICT)
+      {
+        row2 = addrmap_next(off_b, walk->row_mask);
+      }
+
+      off_c = walk->first[2];
+      for (c = 0; c < walk->nb[2]; c++)
+      {
+        if (!addrmap_access(walk, (uintptr_t *)(base | off_a | off_b | off_c),
+                            pattern, write))
+        {
+          return false;
+        }
+
+        /* same column of the other row: each access opens a new row */
+        if ((walk->order == ADDRMAP_ORDER_CONFLICT) &&
+            !addrmap_access(walk, (uintptr_t *)(base | off_a | row2 | off_c),
+                            pattern, write))
+        {
+          return false;
+        }
+
+        off_c = addrmap_next(off_c, walk->mask[2]);
+      }
+
+      off_b = addrmap_next(off_b, walk->mask[1]);
+      if (walk->order == ADDRMAP_ORDER_CONFLICT)
+      {
+        off_b = addrmap_next(off_b, walk->mask[1]);
+      }
+    }
+
+    off_a = addrmap_next(off_a, walk->mask[0]);
+  }
+
+  return true;
+}
+
+static uint32_t addrmap_test(const char *name, int order, unsigned long rows_in,
+                             unsigned long loop_in, unsigned long addr_in)
+{
+  addrmap_walk walk;
+  ddr_addrmap_loc size;
+  ddr_addrmap_loc start;
+  unsigned long bank_mask;
+  unsigned long col_mask;
+  unsigned long row_first;
+  unsigned long nb_row;
+  unsigned long nb_bank;
+  unsigned long nb_col;
+  unsigned long bufsize;
+  uint32_t nb_loop;
+  uint32_t loop = 0;
+  uintptr_t *addr = NULL;
+  unsigned long pattern;
+
+  get_nb_loop(loop_in, &nb_loop, 1);
+
+  if (get_addr(addr_in, &addr) != 0)
+  {
+    return 2;
+  }
+
+  DDR_AddrMap_Update();
+  DDR_AddrMap_Get_Size(&size);
+  if (!DDR_AddrMap_Decode((unsigned long)addr, &start))
+  {
+    test_printf("Address out of the DDR: 0x%lx\n\r", (unsigned long)addr);
+    return 2;
+  }
+
+  nb_row = (rows_in != 0U) ? rows_in : 2;
+  if (((order == ADDRMAP_ORDER_CONFLICT) && ((nb_row & 1U) != 0U)) ||
+      (nb_row > size.row - start.row))
+  {
+    test_printf("Invalid number of rows: %lu (from row 0x%lx, %lu rows%s)\n\r",
+                nb_row, start.row, size.row,
+                (order == ADDRMAP_ORDER_CONFLICT) ? ", even" : "");
+    return 1;
+  }
+
+  /* the columns inside a CPU word are accessed together */
+  bank_mask = addrmap_offset(~0UL, ~0UL, ~0UL, 0, 0);
+  col_mask = addrmap_offset(0, 0, 0, 0, ~0UL) &
+             ~(unsigned long)(sizeof(unsigned long) - 1);
+  row_first = addrmap_offset(0, 0, 0, start.row, 0);
+  nb_bank = 1UL << __builtin_popcountl(bank_mask);
+  nb_col = 1UL << __builtin_popcountl(col_mask);
+
+  if ((bank_mask | col_mask |
+       addrmap_offset(0, 0, 0, start.row + nb_row - 1, 0)) >=
+      (unsigned long)DDR_MEM_SIZE)
+  {
+    test_printf("Rows out of the DDR: 0x%lx..0x%lx\n\r", start.row,
+                start.row + nb_row - 1);
+    return 1;
+  }
+
+  walk.name = name;
+  walk.order = order;
+  walk.row_mask = addrmap_offset(0, 0, 0, ~0UL, 0);
+
+  switch (order)
+  {
+    case ADDRMAP_ORDER_ROW:
+      walk.first[0] = row_first;
+      walk.mask[0] = walk.row_mask;
+      walk.nb[0] = nb_row;
+      walk.first[1] = 0;
+      walk.mask[1] = bank_mask;
+      walk.nb[1] = nb_bank;
+      break;
+    default:
+      walk.first[0] = 0;
+      walk.mask[0] = bank_mask;
+      walk.nb[0] = nb_bank;
+      walk.first[1] = row_first;
+      walk.mask[1] = walk.row_mask;
+      walk.nb[1] = (order == ADDRMAP_ORDER_CONFLICT) ? nb_row / 2 : nb_row;
+      break;
+  }
+  walk.first[2] = 0;
+  walk.mask[2] = col_mask;
+  walk.nb[2] = nb_col;
+
+  bufsize = nb_bank * nb_row * nb_col * sizeof(unsigned long);
+
+  while (1)
+  {
+    pattern = (loop & 1U) ? ~0UL : 0UL;
+
+    if (!addrmap_pass(&walk, pattern, true))
+    {
+      return 3;
+    }
+    test_stats_add(bufsize, 0);
+
+    if (!addrmap_pass(&walk, pattern, false))
+    {
+      return 3;
+    }
+    test_stats_add(0, bufsize);
+
+    if (test_loop_end(&loop, nb_loop))
+    {
+      break;
+    }
+  }
+
+  return 0;
+}
+
+/**
+* @brief test_perbank.
+* @par Test Description
+*   Writes then verifies [rows] rows in each bank, bank by bank, column by
+*   column: row hits, except at the row changes.
+*   The data of each word is its address (inverted at odd loops).
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*/
+uint32_t DDR_Test_PerBank(unsigned long rows, unsigned long loop_in,
+                          unsigned long addr_in)
+{
+  return addrmap_test("test_perbank", ADDRMAP_ORDER_BANK, rows, loop_in,
+                      addr_in);
+}
+
+/**
+* @brief test_perrow.
+* @par Test Description
+*   Writes then verifies [rows] rows, row by row: each row is tested in all
+*   the banks in turn.
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*/
+uint32_t DDR_Test_PerRow(unsigned long rows, unsigned long loop_in,
+                         unsigned long addr_in)
+{
+  return addrmap_test("test_perrow", ADDRMAP_ORDER_ROW, rows, loop_in,
+                      addr_in);
+}
+
+/**
+* @brief test_rowconflict.
+* @par Test Description
+*   Writes then verifies [rows] rows (even) in each bank: the same column of
+*   2 rows of a bank is accessed alternately, so each access is a row miss.
+*   Compared with PerBank, it measures the row-miss throughput.
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*/
+uint32_t DDR_Test_RowConflict(unsigned long rows, unsigned long loop_in,
+                              unsigned long addr_in)
+{
+  return addrmap_test("test_rowconflict", ADDRMAP_ORDER_CONFLICT, rows,
+                      loop_in, addr_in);
+}
+
+/*
+ * STREAM-like kernels on 3 arrays a, b and c of n bytes, 64 bytes per
+ * iteration, with q = 3:
+ *   copy  c = a        scale b = q.c        add   c = a + b
+ *   triad a = b + q.c  then copies and fills using other instructions.
+ * With a[i] = a0 initially, a and c end at 15.a0 and b at 0.
+ */
+#define STREAM_ARRAY_NB         3
+
+typedef struct {
+  const char *name;
+  /* arrays accessed by the kernel: bytes transferred = access * n */
+  unsigned int access;
+  void (*fct)(uintptr_t *a, uintptr_t *b, uintptr_t *c, unsigned long n);
+} stream_kernel;
+
+/* dst = src with 4 LDP and 4 STP */
+static void stream_copy(uintptr_t *a, uintptr_t *b, uintptr_t *c,
+                        unsigned long n)
+{
+  unsigned long offset;
+
+  for (offset = 0; offset < n; offset += DDR_CACHE_LINE)
+  {
+    uintptr_t *src = (uintptr_t *)((unsigned long)a + offset);
+    uintptr_t *dst = (uintptr_t *)((unsigned long)c + offset);
+#ifdef __AARCH64__
+    __asm volatile (
+                    "LDP x8, x9, [%[src]]          \n"
+                    "LDP x10, x11, [%[src], #16]   \n"
+                    "LDP x12, x13, [%[src], #32]   \n"
+                    "LDP x14, x15, [%[src], #48]   \n"
+                    "STP x8, x9, [%[dst]]          \n"
+                    "STP x10, x11, [%[dst], #16]   \n"
+                    "STP x12, x13, [%[dst], #32]   \n"
+                    "STP x14, x15, [%[dst], #48]   \n"
+                    :
+                    : [src] "r" (src), [dst] "r" (dst)
+                    : "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+                      "memory");
+#else
+    unsigned int i;
+
+    for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+    {
+      ((volatile uintptr_t *)dst)[i] = ((volatile uintptr_t *)src)[i];
+    }
+#endif
+  }
+}
+
+/* b = 3.c */
+static void stream_scale(uintptr_t *a, uintptr_t *b, uintptr_t *c,
+                         unsigned long n)
+{
+  unsigned long offset;
+
+  for (offset = 0; offset < n; offset += DDR_CACHE_LINE)
+  {
+    uintptr_t *src = (uintptr_t *)((unsigned long)c + offset);
+    uintptr_t *dst = (uintptr_t *)((unsigned long)b + offset);
+#ifdef __AARCH64__
+    __asm volatile (
+                    "LDP x8, x9, [%[src]]          \n"
+                    "LDP x10, x11, [%[src], #16]   \n"
+                    "LDP x12, x13, [%[src], #32]   \n"
+                    "LDP x14, x15, [%[src], #48]   \n"
+                    "ADD x8, x8, x8, LSL #1        \n"
+                    "ADD x9, x9, x9, LSL #1        \n"
+                    "ADD x10, x10, x10, LSL #1     \n"
+                    "ADD x11, x11, x11, LSL #1     \n"
+                    "ADD x12, x12, x12, LSL #1     \n"
+                    "ADD x13, x13, x13, LSL #1     \n"
+                    "ADD x14, x14, x14, LSL #1     \n"
+                    "ADD x15, x15, x15, LSL #1     \n"
+                    "STP x8, x9, [%[dst]]          \n"
+                    "STP x10, x11, [%[dst], #16]   \n"
+                    "STP x12, x13, [%[dst], #32]   \n"
+                    "STP x14, x15, [%[dst], #48]   \n"
+                    :
+                    : [src] "r" (src), [dst] "r" (dst)
+                    : "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+                      "memory");
+#else
+    unsigned int i;
+
+    for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+    {
+      ((volatile uintptr_t *)dst)[i] = 3 * ((volatile uintptr_t *)src)[i];
+    }
+#endif
+  }
+}
+
+/* dst = src1 + q.src2, q = 1 or 3 (shift 0 or 1), 32 bytes twice */
+#ifdef __AARCH64__
+#define STREAM_ADD_HALF(shift, off)                       \
+                    "LDP x8, x9, [%[src1], #" off "]       \n" \
+                    "LDP x10, x11, [%[src1], #" off "+16]  \n" \
+                    "LDP x12, x13, [%[src2], #" off "]     \n" \
+                    "LDP x14, x15, [%[src2], #" off "+16]  \n" \
+                    "ADD x12, x12, x12, LSL #" shift "     \n" \
+                    "ADD x13, x13, x13, LSL #" shift "     \n" \
+                    "ADD x14, x14, x14, LSL #" shift "     \n" \
+                    "ADD x15, x15, x15, LSL #" shift "     \n" \
+                    "ADD x8, x8, x12                       \n" \
+                    "ADD x9, x9, x13                       \n" \
+                    "ADD x10, x10, x14                     \n" \
+                    "ADD x11, x11, x15                     \n" \
+                    "STP x8, x9, [%[dst], #" off "]        \n" \
+                    "STP x10, x11, [%[dst], #" off "+16]   \n"
+#endif
+
+/* c = a + b */
+static void stream_add(uintptr_t *a, uintptr_t *b, uintptr_t *c,
+                       unsigned long n)
+{
+  unsigned long offset;
+
+  for (offset = 0; offset < n; offset += DDR_CACHE_LINE)
+  {
+    uintptr_t *src1 = (uintptr_t *)((unsigned long)a + offset);
+    uintptr_t *src2 = (uintptr_t *)((unsigned long)b + offset);
+    uintptr_t *dst = (uintptr_t *)((unsigned long)c + offset);
+#ifdef __AARCH64__
+    /* LSL #0: src2 unchanged */
+    __asm volatile (
+                    STREAM_ADD_HALF("0", "0")
+                    STREAM_ADD_HALF("0", "32")
+                    :
+                    : [src1] "r" (src1), [src2] "r" (src2), [dst] "r" (dst)
+                    : "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+                      "memory");
+#else
+    unsigned int i;
+
+    for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+    {
+      ((volatile uintptr_t *)dst)[i] = ((volatile uintptr_t *)src1)[i] +
+                                       ((volatile uintptr_t *)src2)[i];
+    }
+#endif
+  }
+}
+
+/* a = b + 3.c */
+static void stream_triad(uintptr_t *a, uintptr_t *b, uintptr_t *c,
+                         unsigned long n)
+{
+  unsigned long offset;
+
+  for (offset = 0; offset < n; offset += DDR_CACHE_LINE)
+  {
+    uintptr_t *src1 = (uintptr_t *)((unsigned long)b + offset);
+    uintptr_t *src2 = (uintptr_t *)((unsigned long)c + offset);
+    uintptr_t *dst = (uintptr_t *)((unsigned long)a + offset);
+#ifdef __AARCH64__
+    __asm volatile (
+                    STREAM_ADD_HALF("1", "0")
+                    STREAM_ADD_HALF("1", "32")
+                    :
+                    : [src1] "r" (src1), [src2] "r" (src2), [dst] "r" (dst)
+                    : "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+                      "memory");
+#else
+    unsigned int i;
+
+    for (i = 0; i < DDR_CACHE_LINE_WORDS; i++)
+    {
+      ((volatile uintptr_t *)dst)[i] = ((volatile uintptr_t *)src1)[i] +
+                                       3 * ((volatile uintptr_t *)src2)[i];
+    }
+#endif
+  }
+}
+
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+/* c = a with NEON LD1/ST1 of 4 registers */
+static void stream_copy_neon(uintptr_t *a, uintptr_t *b, uintptr_t *c,
+                             unsigned long n)
+{
+  unsigned long offset;
+
+  for (offset = 0; offset < n; offset += DDR_CACHE_LINE)
+  {
+    __asm volatile (
+                    "LD1 {v0.2d, v1.2d, v2.2d, v3.2d}, [%[src]] \n"
+                    "ST1 {v0.2d, v1.2d, v2.2d, v3.2d}, [%[dst]] \n"
+                    :
+                    : [src] "r" ((unsigned long)a + offset),
+                      [dst] "r" ((unsigned long)c + offset)
+                    : "v0", "v1", "v2", "v3", "memory");
+  }
+}
+#endif /* __AARCH64__ && TEST_NEON_ENABLE */
+
+/* c = a with the non-temporal LDNP/STNP */
+static void stream_copy_nt(uintptr_t *a, uintptr_t *b, uintptr_t *c,
+                           unsigned long n)
+{
+#ifdef __AARCH64__
+  unsigned long offset;
+
+  for (offset = 0; offset < n; offset += DDR_CACHE_LINE)
+  {
+    __asm volatile (
+                    "LDNP x8, x9, [%[src]]         \n"
+                    "LDNP x10, x11, [%[src], #16]  \n"
+                    "LDNP x12, x13, [%[src], #32]  \n"
+                    "LDNP x14, x15, [%[src], #48]  \n"
+                    "STNP x8, x9, [%[dst]]         \n"
+                    "STNP x10, x11, [%[dst], #16]  \n"
+                    "STNP x12, x13, [%[dst], #32]  \n"
+                    "STNP x14, x15, [%[dst], #48]  \n"
+                    :
+                    : [src] "r" ((unsigned long)a + offset),
+                      [dst] "r" ((unsigned long)c + offset)
+                    : "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+                      "memory");
+  }
+#else
+  stream_copy(a, b, c, n);
+#endif
+}
+
+/* b = pattern with 4 STP */
+static void stream_fill(uintptr_t *a, uintptr_t *b, uintptr_t *c,
+                        unsigned long n)
+{
+  unsigned long offset;
+
+  for (offset = 0; offset < n; offset += DDR_CACHE_LINE)
+  {
+    march_write((uintptr_t *)((unsigned long)b + offset), 0x5555AAAA5555AAAAUL);
+  }
+}
+
+/* b = 0 with DC ZVA, or 4 STP of XZR when DC ZVA is not usable */
+static void stream_zero(uintptr_t *a, uintptr_t *b, uintptr_t *c,
+                        unsigned long n)
+{
+  unsigned long offset;
+  bool zero = cache_zero_usable();
+
+  for (offset = 0; offset < n; offset += DDR_CACHE_LINE)
+  {
+    if (zero)
+    {
+      cache_zero((void *)((unsigned long)b + offset));
+    }
+    else
+    {
+      march_write((uintptr_t *)((unsigned long)b + offset), 0);
+    }
+  }
+  cache_sync();
+}
+
+static const stream_kernel stream_kernels[] = {
+  {"copy", 2, stream_copy},
+  {"scale", 2, stream_scale},
+  {"add", 3, stream_add},
+  {"triad", 3, stream_triad},
+#if defined(__AARCH64__) && defined(TEST_NEON_ENABLE)
+  {"copy-neon", 2, stream_copy_neon},
+#endif
+  {"copy-stnp", 2, stream_copy_nt},
+  {"fill", 1, stream_fill},
+  {"zero-zva", 1, stream_zero},
+};
+
+#define STREAM_KERNEL_NB  (sizeof(stream_kernels) / sizeof(stream_kernels[0]))
+
+/**
+* @brief test_stream.
+* @par Test Description
+*   STREAM-like sustained bandwidth: the kernels copy, scale, add, triad,
+*   NEON copy, non-temporal copy, fill and DC ZVA zero run in turn on 3
+*   arrays of [size] / 3 bytes, [loop] times (10 by default). The best and
+*   average bandwidth of each kernel are printed, followed by
+*   STREAM;<kernel>;<array bytes>;<loops>;<best MB/s>;<avg MB/s>
+*   or by a SAMPLE frame with "tlm on".
+*   The arrays are verified after each loop.
+* @par Required preconditions
+* - Address aligned on 64 bytes
+* @retval
+*  0: Test passed
+*  Value different from 0: Test failed
+*/
+uint32_t DDR_Test_Stream(unsigned long size, unsigned long loop_in,
+                         unsigned long addr_in)
+{
+  unsigned long best[STREAM_KERNEL_NB];
+  uint64_t total_us[STREAM_KERNEL_NB];
+  unsigned long bufsize;
+  unsigned long end;
+  unsigned long n;
+  unsigned long bytes;
+  unsigned long mbs;
+  unsigned long value;
+  unsigned long data;
+  uint32_t nb_loop;
+  uint32_t loop = 0;
+  uintptr_t *addr = NULL;
+  uintptr_t *array[STREAM_ARRAY_NB];
+  uint64_t ticks;
+  uint64_t us;
+  unsigned int k;
+  unsigned long i;
+
+  if (get_buf_size(size, &bufsize, 0x1800000, 256) != 0)
+  {
+    return 1;
+  }
+
+  get_nb_loop(loop_in, &nb_loop, 10);
+  if (nb_loop == 0xFFFFFFFF)
+  {
+    test_printf("Invalid loop number: infinite\n\r");
+    return 1;
+  }
+
+  if (get_addr(addr_in, &addr) != 0)
+  {
+    return 2;
+  }
+
+  if (((unsigned long)addr & (DDR_CACHE_LINE - 1)) != 0U)
+  {
+    test_printf("Unaligned address: 0x%lx (line=0x%x)\n\r", (unsigned long)addr,
+                DDR_CACHE_LINE);
+    return 2;
+  }
+
+  /* the default size is limited to the DDR after addr */
+  end = (unsigned long)DDR_MEM_BASE + (unsigned long)DDR_MEM_SIZE;
+  if ((size == 0U) && ((unsigned long)addr < end) &&
+      (bufsize > end - (unsigned long)addr))
+  {
+    bufsize = (end - (unsigned long)addr) & ~0xFFUL;
+  }
+
+  if (((unsigned long)addr >= end) || (bufsize > end - (unsigned long)addr))
+  {
+    test_printf("Buffer out of the DDR: 0x%lx..0x%lx\n\r", (unsigned long)addr,
+                (unsigned long)addr + bufsize - 1U);
+    return 2;
+  }
+
+  if (check_reserved((unsigned long)addr, bufsize) != 0)
+  {
+    return 2;
+  }
+
+  n = (bufsize / STREAM_ARRAY_NB) & ~(unsigned long)(DDR_CACHE_LINE - 1);
+  if (n == 0U)
+  {
+    test_printf("Invalid size: 0x%lx\n\r", bufsize);
+    return 1;
+  }
+  for (k = 0; k < STREAM_ARRAY_NB; k++)
+  {
+    array[k] = (uintptr_t *)((unsigned long)addr + k * n);
+  }
+
+  memset(best, 0, sizeof(best));
+  memset(total_us, 0, sizeof(total_us));
+
+  while (1)
+  {
+    for (i = 0; i < n / sizeof(uintptr_t); i++)
+    {
+      array[0][i] = (unsigned long)&array[0][i];
+    }
+    test_stats_add(n, 0);
+
+    for (k = 0; k < STREAM_KERNEL_NB; k++)
+    {
+      bytes = stream_kernels[k].access * n;
+
+      ticks = timer_get_count();
+      stream_kernels[k].fct(array[0], array[1], array[2], n);
+      cache_sync();
+      ticks = timer_get_count() - ticks;
+
+      /* the bytes written are counted in 'access' */
+      test_stats_add(n, bytes - n);
+
+      us = timer_ticks_to_us(ticks);
+      if (us == 0U)
+      {
+        us = 1;
+      }
+      total_us[k] += us;
+      mbs = (unsigned long)(bytes / us);
+      if (mbs > best[k])
+      {
+        best[k] = mbs;
+      }
+    }
+
+    /* a = c = 15.a0, b = 0 */
+    for (i = 0; i < n / sizeof(uintptr_t); i++)
+    {
+      value = 15 * (unsigned long)&array[0][i];
+      data = array[0][i];
+      if ((data != value) && test_error(&array[0][i], value, data))
+      {
+        test_printf("  test_stream KO @ 0x%lx\n\r", (unsigned long)&array[0][i]);
+        test_printf("  read 0x%lx instead of 0x%lx\n\r", data, value);
+        return 3;
+      }
+
+      data = array[2][i];
+      if ((data != value) && test_error(&array[2][i], value, data))
+      {
+        test_printf("  test_stream KO @ 0x%lx\n\r", (unsigned long)&array[2][i]);
+        test_printf("  read 0x%lx instead of 0x%lx\n\r", data, value);
+        return 3;
+      }
+
+      data = array[1][i];
+      if ((data != 0U) && test_error(&array[1][i], 0, data))
+      {
+        test_printf("  test_stream KO @ 0x%lx\n\r", (unsigned long)&array[1][i]);
+        test_printf("  read 0x%lx instead of 0x0\n\r", data);
+        return 3;
+      }
+    }
+    test_stats_add(0, STREAM_ARRAY_NB * n);
+
+    if (test_loop_end(&loop, nb_loop))
+    {
+      break;
+    }
+  }
+
+  test_info("  %lu bytes per array, %u loops\n\r", n, loop);
+  for (k = 0; k < STREAM_KERNEL_NB; k++)
+  {
+    bytes = stream_kernels[k].access * n;
+    mbs = (unsigned long)((bytes * (uint64_t)loop) / total_us[k]);
+    test_info("  %-10s best %6lu MB/s, avg %6lu MB/s\n\r",
+              stream_kernels[k].name, best[k], mbs);
+    test_info("STREAM;%s;%lu;%u;%lu;%lu\n\r", stream_kernels[k].name, n, loop,
+              best[k], mbs);
+    if (DDR_Tlm_Get_Enable())
+    {
+      unsigned long value[] = {n, loop, best[k], mbs};
+
+      DDR_Tlm_Sample("STREAM", stream_kernels[k].name, value, 4);
+    }
+  }
+
+  return 0;
+}
+
 #ifdef TEST_INFINITE_ENABLE
 /**
 * @brief test infinite write access to DDR
@@ -1714,6 +3954,8 @@ uint32_t DDR_Test_Infinite_write(unsigned long pattern_in, unsigned long addr_in
   bool random = false;
   volatile uint32_t go_loop = 1U;
   unsigned long dflt_pattern = 0xA5A5AA55AAAA5555;
+  uint64_t seed = 0;
+  uint64_t state = 0;
 
   if (get_addr(addr_in, &addr) != 0)
   {
@@ -1724,12 +3966,14 @@ uint32_t DDR_Test_Infinite_write(unsigned long pattern_in, unsigned long addr_in
 
   if ((unsigned long)addr == 0xC8888888)
   {
-    printf("running random\n\r");
+    seed = prng_seed();
+    state = prng_mix(seed);
+    test_printf("running random, seed 0x%lx\n\r", (unsigned long)seed);
     random = true;
   }
   else
   {
-    printf("running at 0x%lx with pattern 0x%lx\n\r", (unsigned long)addr, data);
+    test_info("running at 0x%lx with pattern 0x%lx\n\r", (unsigned long)addr, data);
   }
 
   while (go_loop != 0U)
@@ -1738,12 +3982,14 @@ uint32_t DDR_Test_Infinite_write(unsigned long pattern_in, unsigned long addr_in
     {
       if (random)
       {
-        addr = (uintptr_t *)(unsigned long)((rand() & (DDR_MEM_SIZE - 1) & ~0x3));
-        data = rand();
+        addr = (uintptr_t *)((unsigned long)DDR_MEM_BASE +
+                             (prng_next(&state) & (DDR_MEM_SIZE - 1) & ~0x7UL));
+        data = prng_next(&state);
       }
 
       *addr = data;
     }
+    test_stats_add(size * sizeof(unsigned long), 0);
 
     if (test_loop_end(&loop, nb_loop))
     {
@@ -1783,6 +4029,8 @@ uint32_t DDR_Test_Infinite_read(unsigned long pattern_in, unsigned long addr_in)
   bool random = false;
   volatile uint32_t go_loop = 1U;
   unsigned long dflt_pattern = 0xA5A5AA55AAAA5555;
+  uint64_t seed = 0;
+  uint64_t state = 0;
 
   if (get_addr(addr_in, &addr) != 0)
   {
@@ -1793,12 +4041,14 @@ uint32_t DDR_Test_Infinite_read(unsigned long pattern_in, unsigned long addr_in)
 
   if ((unsigned long)addr == 0xC8888888)
   {
-    printf("running random\n\r");
+    seed = prng_seed();
+    state = prng_mix(seed);
+    test_printf("running random, seed 0x%lx\n\r", (unsigned long)seed);
     random = true;
   }
   else
   {
-    printf("running at 0x%lx with pattern 0x%lx\n\r", (unsigned long)addr, data);
+    test_info("running at 0x%lx with pattern 0x%lx\n\r", (unsigned long)addr, data);
     *addr = data;
   }
 
@@ -1807,11 +4057,13 @@ uint32_t DDR_Test_Infinite_read(unsigned long pattern_in, unsigned long addr_in)
     for (i = 0; i < size; i++)
     {
       if (random)
-        addr = (uintptr_t *)(unsigned long)((rand() & (DDR_MEM_SIZE - 1) & ~0x3));
+        addr = (uintptr_t *)((unsigned long)DDR_MEM_BASE +
+                             (prng_next(&state) & (DDR_MEM_SIZE - 1) & ~0x7UL));
 
       data = *addr;
-      printf("data @ address 0x%lx = 0x%lx \n\r", (unsigned long)addr, data);
+      test_info("data @ address 0x%lx = 0x%lx \n\r", (unsigned long)addr, data);
     }
+    test_stats_add(0, size * sizeof(unsigned long));
 
     if (test_loop_end(&loop, nb_loop))
     {
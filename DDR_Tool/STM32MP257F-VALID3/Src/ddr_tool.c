@@ -22,6 +22,13 @@
 #include "string.h"
 #include "stdlib.h"
 #include "ddr_tool.h"
+#include "ddr_addrmap.h"
+#include "ddr_tool_dma.h"
+#include "ddr_tool_latency.h"
+#include "ddr_tool_smp.h"
+#include "ddr_tool_tlm.h"
+#include "ddr_tool_trace.h"
+#include "system_time.h"
 #include "stm32mp_util_conf.h"
 
 /* Private typedef -----------------------------------------------------------*/
@@ -46,6 +53,18 @@ typedef enum {
   DDR_CMD_NEXT,
   DDR_CMD_GO,
   DDR_CMD_TEST,
+  DDR_CMD_ERROR,
+  DDR_CMD_SMP,
+  DDR_CMD_CACHE,
+  DDR_CMD_SEED,
+  DDR_CMD_DMA,
+  DDR_CMD_ADDRMAP,
+  DDR_CMD_LATENCY,
+  DDR_CMD_SCRIPT,
+  DDR_CMD_TLM,
+  DDR_CMD_BAUD,
+  DDR_CMD_TRACE,
+  DDR_CMD_TRAINING,
   DDR_CMD_UNKNOWN,
   DDR_CMD_TEST_HELP,
   DDR_CMD_MAX,
@@ -64,6 +83,8 @@ typedef struct {
 
 /* Private define ------------------------------------------------------------*/
 #define CMD_MAX_LEN 1024
+#define SCRIPT_MAX_LEN 8192
+#define SCRIPT_MAX_DEPTH 8
 #define CMD_MAX_ARG 3
 #define DDR_NAME_MAX_LEN 128
 
@@ -106,6 +127,22 @@ const subcmd_desc test[] = {
    "test Walking Ones pattern", 3},
   {DDR_Test_WalkingOnes, "Test WalkingOnes", "[size] [loop] [addr]",
    "test Walking Zeroes pattern", 3},
+  {DDR_Test_CacheLine, "Test CacheLine", "[size] [loop] [addr]",
+   "full cache line write-back and refetch (DC ZVA/DC CIVAC)", 3},
+  {DDR_Test_MarchCMinus, "Test MarchC-", "[size] [loop] [addr]",
+   "March C- (10n), data background changed at each loop", 3},
+  {DDR_Test_MarchSS, "Test MarchSS", "[size] [loop] [addr]",
+   "March SS (22n), data background changed at each loop", 3},
+  {DDR_Test_MatsPlus, "Test MATS+", "[size] [loop] [addr]",
+   "MATS+ (5n), data background changed at each loop", 3},
+  {DDR_Test_PerBank, "Test PerBank", "[rows] [loop] [addr]",
+   "all banks, bank by bank, [rows] rows from the row of [addr]", 3},
+  {DDR_Test_PerRow, "Test PerRow", "[rows] [loop] [addr]",
+   "[rows] rows from the row of [addr], each in all banks", 3},
+  {DDR_Test_RowConflict, "Test RowConflict", "[rows] [loop] [addr]",
+   "2 rows of each bank accessed alternately (row miss)", 3},
+  {DDR_Test_Stream, "Test Stream", "[size] [loop] [addr]",
+   "STREAM-like kernels on 3 arrays, best/avg MB/s per kernel", 3},
 #ifdef TEST_INFINITE_ENABLE
   {DDR_Test_Infinite_write, "Test infinite write for JEDEC", "[pattern] [addr]",
    "test infinite write pattern", 2},
@@ -137,6 +174,18 @@ const ddr_command ddr_cmd[DDR_CMD_MAX] = {
     [DDR_CMD_NEXT]         = { "next"       , 0, 0 },
     [DDR_CMD_GO]           = { "go"         , 0, 0 },
     [DDR_CMD_TEST]         = { "test"       , 0, CMD_MAX_ARG },
+    [DDR_CMD_ERROR]        = { "error"      , 0, 1 },
+    [DDR_CMD_SMP]          = { "smp"        , 0, 1 },
+    [DDR_CMD_CACHE]        = { "cache"      , 0, 1 },
+    [DDR_CMD_SEED]         = { "seed"       , 0, 1 },
+    [DDR_CMD_DMA]          = { "dma"        , 0, 3 },
+    [DDR_CMD_ADDRMAP]      = { "addrmap"    , 0, 1 },
+    [DDR_CMD_LATENCY]      = { "latency"    , 0, 3 },
+    [DDR_CMD_SCRIPT]       = { "script"     , 1, 2 },
+    [DDR_CMD_TLM]          = { "tlm"        , 0, 1 },
+    [DDR_CMD_BAUD]         = { "baud"       , 0, 1 },
+    [DDR_CMD_TRACE]        = { "trace"      , 0, 1 },
+    [DDR_CMD_TRAINING]     = { "training"   , 0, 2 },
     [DDR_CMD_TEST_HELP]    = { "test help"  , 0, 0 },
 };
 
@@ -144,13 +193,126 @@ const ddr_command ddr_cmd[DDR_CMD_MAX] = {
 /* Private variables ---------------------------------------------------------*/
 extern HAL_DDR_ConfigTypeDef static_ddr_config;
 
+/* commands received by "script load", executed by "script run" */
+static char script_buf[SCRIPT_MAX_LEN];
+static size_t script_len;
+static bool script_running;
+
+/* set by the failing commands, to stop the scripts */
+static bool cmd_failed;
+
+/* index of the HAL_DDR_CDD_xx types */
+static const char * const cdd_str[HAL_DDR_CDD_NB] = {"rr", "ww", "rw", "wr"};
+
 /* Private function prototypes -----------------------------------------------*/
+static void execute_command(HAL_DDR_InteractStepTypeDef step, int cmd,
+                            int argc, char *argv[], int *next_step);
 /* Private functions ---------------------------------------------------------*/
 
+/*
+ * Report the DDR traffic of test[id] since 'start' and its bandwidth, followed
+ * by a machine-readable summary line:
+ * PERF;<id>;<test name>;<result>;<bytes written>;<bytes read>;<elapsed us>;
+ *      <MB/s>;<DDR name>;<DDR speed kHz>;<DDR mapping NC|WB>
+ * or by a RESULT frame with "tlm on".
+ */
+static void print_test_stats(int id, uint32_t ret, uint64_t ticks,
+                             const ddr_test_stats *start)
+{
+  ddr_test_stats stats;
+  unsigned long written;
+  unsigned long read;
+  unsigned long elapsed_us;
+  unsigned long bandwidth = 0;
+
+  DDR_Test_Stats_Get(&stats);
+  written = stats.written - start->written;
+  read = stats.read - start->read;
+  elapsed_us = (unsigned long)timer_ticks_to_us(ticks);
+
+  if (DDR_Tlm_Get_Enable())
+  {
+    DDR_Tlm_Result(id, (DDR_Smp_Get_Enable() ? DDR_TLM_FLAG_SMP : 0U) |
+                       (DDR_Test_Get_Cache() ? DDR_TLM_FLAG_WB : 0U),
+                   ret, static_ddr_config.info.speed, written, read,
+                   elapsed_us, test[id].name, static_ddr_config.info.name);
+    return;
+  }
+
+  /* bytes per microsecond = MB/s */
+  if (elapsed_us != 0U)
+  {
+    bandwidth = (written + read) / elapsed_us;
+  }
+
+  printf("  written %lu bytes, read %lu bytes in %lu.%06lu s => %lu MB/s\n\r",
+         written, read, elapsed_us / 1000000, elapsed_us % 1000000, bandwidth);
+  printf("PERF;%d;%s;%d;%lu;%lu;%lu;%lu;%s;%d;%s\n\r", id, test[id].name, ret,
+         written, read, elapsed_us, bandwidth, static_ddr_config.info.name,
+         static_ddr_config.info.speed, DDR_Test_Get_Cache() ? "WB" : "NC");
+}
+
+/*
+ * The tests with [size] as 1st argument can be split on both cores, except
+ * AddressBus (aliasing checked on the whole range) and Stream (bandwidth of
+ * one core).
+ */
+static bool test_is_splittable(int id)
+{
+  return (strncmp(test[id].usage, "[size]", 6) == 0) &&
+         (test[id].fct != DDR_Test_AddressBus) &&
+         (test[id].fct != DDR_Test_Stream);
+}
+
+static uint32_t test_call(int id, const unsigned long *arg, bool smp)
+{
+  uint32_t ret;
+
+  if (smp)
+  {
+    DDR_Test_Smp_Seed(true);
+    ret = DDR_Smp_Run(test[id].fct, test[id].max_args, arg);
+    DDR_Test_Smp_Seed(false);
+
+    return ret;
+  }
+
+  switch (test[id].max_args)
+  {
+    case 0:
+      return test[id].fct();
+    case 1:
+      return test[id].fct(arg[0]);
+    case 2:
+      return test[id].fct(arg[0], arg[1]);
+    case 3:
+      return test[id].fct(arg[0], arg[1], arg[2]);
+    default:
+      printf("Number of arguments not supported\n\r");
+      return 0XFFFFFFFF;
+  }
+}
+
+static uint32_t test_run(int id, const unsigned long *arg)
+{
+  bool smp = DDR_Smp_Get_Enable() && test_is_splittable(id);
+  uint32_t ret;
+
+  DDR_Trace(DDR_TRACE_TEST_START, (uint32_t)id, smp ? 1U : 0U);
+  ret = test_call(id, arg, smp);
+  DDR_Trace(DDR_TRACE_TEST_END, (uint32_t)id, ret);
+
+  return ret;
+}
+
 static uint32_t DDR_Test_All(uint32_t loop, uint32_t size, uint32_t addr)
 {
   uint32_t ret = 0;
+  uint32_t result = 0;
   int i;
+  unsigned long arg[CMD_MAX_ARG];
+  ddr_test_stats start;
+  uint64_t ticks;
 
 #ifdef TEST_INFINITE_ENABLE
   for (i = 1; i < (int)test_nb - 2; i++)
@@ -158,48 +320,68 @@ static uint32_t DDR_Test_All(uint32_t loop, uint32_t size, uint32_t addr)
   for (i = 1; i < (int)test_nb; i++)
 #endif
   {
+    DDR_Test_Stats_Get(&start);
+    DDR_Test_Errors_Reset();
+    ticks = timer_get_count();
+
     switch (test[i].max_args)
     {
       case 1:
-        ret = test[i].fct(addr);
+        arg[0] = addr;
         break;
       case 2:
         if (   (test[i].fct == DDR_Test_DatabusWalk0)
             || (test[i].fct == DDR_Test_DatabusWalk1))
         {
-          ret = test[i].fct(loop, addr);
+          arg[0] = loop;
         }
         else if (test[i].fct == DDR_Test_Noise)
         {
-          ret = test[i].fct(0, addr);
+          arg[0] = 0;
         }
         else
         {
-          ret = test[i].fct(size, addr);
+          arg[0] = size;
         }
+        arg[1] = addr;
         break;
       case 3:
-        if (test[i].fct == DDR_Test_NoiseBurst)
-        {
-          ret = test[i].fct(size, 0, addr);
-        }
-        else
-        {
-          ret = test[i].fct(size, loop, addr);
-        }
+        /* [rows] tests use their default number of rows */
+        arg[0] = (strncmp(test[i].usage, "[rows]", 6) == 0) ? 0 : size;
+        arg[1] = (test[i].fct == DDR_Test_NoiseBurst) ? 0 : loop;
+        arg[2] = addr;
         break;
     }
 
+    ret = test_run(i, arg);
+
+    ticks = timer_get_count() - ticks;
+
+    if ((DDR_Test_Errors_Report() != 0U) && (ret == 0U))
+    {
+      ret = DDR_TEST_ERRORS_ACCUMULATED;
+    }
+
     if (ret != 0)
     {
       printf("%s failed [%d]\n\r", test[i].name, ret);
-      return ret;
+      print_test_stats(i, ret, ticks, &start);
+
+      /* In continue-on-error mode, run the remaining tests */
+      if (!DDR_Test_Get_Continue())
+      {
+        return ret;
+      }
+
+      result = ret;
+      continue;
     }
 
     printf("result %d:%s = Passed\n\r", i, test[i].name);
+    print_test_stats(i, ret, ticks, &start);
   }
 
-  return ret;
+  return result;
 }
 
 static void get_entry_string(char *entry)
@@ -229,9 +411,12 @@ static void get_entry_string(char *entry)
     }
     else if (user_entry_value == 0x18)
     {
-      i--;
+      if (i > 0)
+      {
+        i--;
+      }
     }
-    else
+    else if (i < CMD_MAX_LEN - 1)
     {
       entry[i++] = user_entry_value;
     }
@@ -384,6 +569,42 @@ static void print_usage(void)
     "go                         continues the DDR TOOL execution\n\r"
     "reset                      reboots machine\n\r"
     "test [help] | <n> [...]    lists (with help) or executes test <n>\n\r"
+    "error [stop|continue]      displays or selects the test behavior on error:\n\r"
+    "                           stop at first error or continue and report\n\r"
+    "                           errors per byte lane and DQ bit\n\r"
+    "smp [on|off]               displays or selects the execution of the\n\r"
+    "                           range tests on both A35 cores\n\r"
+    "cache [on|off]             displays or selects the DDR mapping:\n\r"
+    "                           cacheable write-back or non-cacheable\n\r"
+    "seed [value]               displays or selects the seed of the random\n\r"
+    "                           tests, 0 = new seed for each test\n\r"
+    "dma [off]                  displays or stops the DMA background traffic\n\r"
+    "dma <copy|fill> [size] [addr]\n\r"
+    "                           starts the DMA background traffic\n\r"
+    "dma bench [size] [addr]    DMA-only bandwidth benchmark\n\r"
+    "addrmap [addr]             displays the DDRC address map or the\n\r"
+    "                           rank/bank/row/column of <addr>\n\r"
+    "latency [chain] [size] [addr]\n\r"
+    "                           load latency histograms of the pointer\n\r"
+    "                           chains: hit, miss, conflict, random or\n\r"
+    "                           <stride> in bytes, all by default\n\r"
+    "script load                receives a script, up to a line \"end\"\n\r"
+    "script list                displays the script\n\r"
+    "script run [stop|continue] executes the script, stops or continues\n\r"
+    "                           on a failing command (default: stop)\n\r"
+    "tlm [on|off]               displays or selects the output of the tests\n\r"
+    "                           and of print/save: text or binary frames\n\r"
+    "                           decoded by DDR_Tool/Host ddr_tlm\n\r"
+    "baud [rate]                displays or changes the console baud rate,\n\r"
+    "                           confirmed by Enter at the new rate\n\r"
+    "trace [clear]              displays or clears the event trace of the\n\r"
+    "                           DDR initialization and of the tests\n\r"
+    "training                   displays the results of the last training\n\r"
+    "                           read from the PHY message block\n\r"
+    "training log [clear]       displays or clears the messages of the PHY\n\r"
+    "                           training firmware\n\r"
+    "cmd1; cmd2                 executes several commands\n\r"
+    "repeat <n> { ... }         executes the commands of the block n times\n\r"
     "\n\rwith for [type|reg]:\n\r"
     "  all registers if absent\n\r"
     "  <type> = ctl, uib, uia, uim, uis\n\r"
@@ -482,6 +703,8 @@ static void do_info(HAL_DDR_InteractStepTypeDef step, int argc, char *argv[])
     printf("name = %s\n\r", static_ddr_config.info.name);
     printf("size = 0x%lx\n\r", static_ddr_config.info.size);
     printf("speed = %d kHz\n\r", static_ddr_config.info.speed);
+    UART_Tx_Info();
+    DDR_Trace_Profile();
     return;
   }
 
@@ -549,365 +772,1153 @@ static void do_info(HAL_DDR_InteractStepTypeDef step, int argc, char *argv[])
   printf("argument %s invalid\n\r", argv[0]);
 }
 
-static bool do_freq(int argc, char *argv[])
+static void do_error(int argc, char *argv[])
 {
-  unsigned long frequency;
-  unsigned long value;
-  char *end_ptr;
-  bool ret_code = true;
-
   if (argc == 2)
   {
-    /* DDR freq = PLL2 freq * 2 */
-    value = (strtoll(argv[0], &end_ptr, 0) * 1000) / 2;
-    if (end_ptr == argv[0])
+    if (!strcmp(argv[0], "stop"))
     {
-      printf("invalid argument %s\n\r", argv[0]);
-      return false;
+      DDR_Test_Set_Continue(false);
+    }
+    else if (!strcmp(argv[0], "continue"))
+    {
+      DDR_Test_Set_Continue(true);
+    }
+    else
+    {
+      printf("argument %s invalid\n\r", argv[0]);
+      return;
     }
+  }
 
-    frequency = (unsigned long)HAL_RCCEx_GetPLL2ClockFreq();
-    if (value == frequency)
+  printf("error = %s\n\r", DDR_Test_Get_Continue() ? "continue" : "stop");
+}
+
+static void do_smp(int argc, char *argv[])
+{
+  if (argc == 2)
+  {
+    if (!strcmp(argv[0], "on"))
     {
-      printf("Same frequency, no change.\n\r");
-      return true;
+      (void)DDR_Smp_Set_Enable(true);
     }
-    else if (frequency == 0)
+    else if (!strcmp(argv[0], "off"))
     {
-      printf("Frequency has never been set before, no change.\n\r");
-      return true;
+      (void)DDR_Smp_Set_Enable(false);
     }
     else
     {
-      ret_code = pll2_set_rate(value);
+      printf("argument %s invalid\n\r", argv[0]);
+      return;
     }
   }
 
-  frequency = (unsigned long)HAL_RCCEx_GetPLL2ClockFreq();
-  printf("DDRPHY = %ld kHz\n\r", (2 * frequency) / 1000);
-
-  return ret_code;
+  printf("smp = %s\n\r", DDR_Smp_Get_Enable() ? "on" : "off");
 }
 
-static void do_param(HAL_DDR_InteractStepTypeDef step, int argc, char *argv[])
+static void do_tlm(int argc, char *argv[])
 {
-  char reg_name[(argc == 1)? 0 : strlen(argv[0])];
-
-  switch (argc)
+  if (argc == 2)
   {
-  case 1:
-    HAL_DDR_Dump_Param(&static_ddr_config, NULL);
-    break;
-  case 2:
-    HAL_DDR_Convert_Case(argv[0], reg_name, 1); /* convert to upper case */
-
-    if (HAL_DDR_Dump_Param(&static_ddr_config, reg_name) != HAL_OK)
+    if (!strcmp(argv[0], "on"))
     {
-      printf("invalid argument %s\n\r", argv[0]);
+      DDR_Tlm_Set_Enable(true);
     }
-    break;
-  case 3:
-    if (!check_step(step, STEP_DDR_RESET))
+    else if (!strcmp(argv[0], "off"))
+    {
+      DDR_Tlm_Set_Enable(false);
+    }
+    else
     {
+      printf("argument %s invalid\n\r", argv[0]);
       return;
     }
-    HAL_DDR_Convert_Case(argv[0], reg_name, 1); /* convert to upper case */
-    HAL_DDR_Edit_Param(&static_ddr_config, reg_name, argv[1]);
-    break;
   }
+
+  printf("tlm = %s\n\r", DDR_Tlm_Get_Enable() ? "on" : "off");
 }
 
-static void do_print(int argc, char * const argv[])
+/* dump the registers as REG frames with "tlm on" */
+static HAL_StatusTypeDef dump_reg(const char *name, bool save)
 {
-  char reg_name[(argc == 1)? 0 : strlen(argv[0])];
+  HAL_StatusTypeDef ret;
 
-  switch (argc)
+  if (!DDR_Tlm_Get_Enable())
   {
-    case 1:
-      HAL_DDR_Dump_Reg(NULL, false);
-      break;
-    case 2:
-      HAL_DDR_Convert_Case(argv[0], reg_name, 1); /* convert to upper case */
-
-      if (HAL_DDR_Dump_Reg(reg_name, false) != HAL_OK)
-      {
-        printf("invalid argument %s\n\r", reg_name);
-      }
-      break;
+    return HAL_DDR_Dump_Reg(name, save);
   }
+
+  HAL_DDR_Set_Reg_Output(DDR_Tlm_Reg);
+  ret = HAL_DDR_Dump_Reg(name, save);
+  DDR_Tlm_Flush();
+  HAL_DDR_Set_Reg_Output(NULL);
+
+  return ret;
 }
 
-static HAL_DDR_InteractStepTypeDef do_step(HAL_DDR_InteractStepTypeDef step,
-                                           int argc, char *argv[])
+static void do_trace(int argc, char *argv[])
 {
-  int i;
-  unsigned long value;
-  char *end_ptr;
+  if (argc == 2)
+  {
+    if (strcmp(argv[0], "clear"))
+    {
+      printf("argument %s invalid\n\r", argv[0]);
+      cmd_failed = true;
+      return;
+    }
 
-  switch (argc)
+    DDR_Trace_Clear();
+    return;
+  }
+
+  DDR_Trace_Dump();
+}
+
+/*
+ * Print the training results of each P-state, followed by machine-readable
+ * lines:
+ * TRAIN;<pstate>;<firmware revision>;<cstestfail>;<channels>;<ranks>
+ * CDD;<pstate>;<rr|ww|rw|wr>;<channel>;<from rank>;<to rank>;<value>
+ * VREF;<pstate>;<rank>;<VrefDQ of each nibble>...
+ * or only by the same lines in SAMPLE frames with "tlm on", the label being
+ * <pstate> or <pstate>;<rr|ww|rw|wr>.
+ */
+static void training_report(unsigned int pstate,
+                            const HAL_DDR_TrainingResultTypeDef *res)
+{
+  bool tlm = DDR_Tlm_Get_Enable();
+  unsigned long value[HAL_DDR_TRAINING_NIBBLE_MAX + 1];
+  char label[16];
+  unsigned int ch;
+  unsigned int type;
+  unsigned int from;
+  unsigned int to;
+  unsigned int i;
+  int8_t cdd;
+
+  snprintf(label, sizeof(label), "%u", pstate);
+  if (tlm)
   {
-    case 1:
-      for (i = 0; i <= STEP_RUN; i++)
-      {
-        printf("%d:%s\n\r", i, step_str[i]);
-      }
-      break;
+    value[0] = res->revision;
+    value[1] = res->cs_test_fail;
+    value[2] = res->channel_nb;
+    value[3] = res->rank_nb;
+    DDR_Tlm_Sample("TRAIN", label, value, 4);
+  }
+  else
+  {
+    printf("P%u: firmware 0x%04x, CS test %s (0x%02x), %u rank(s)\n\r", pstate,
+           res->revision, res->cs_test_fail ? "failed" : "passed",
+           res->cs_test_fail, res->rank_nb);
+    printf("TRAIN;%u;%u;%u;%u;%u\n\r", pstate, res->revision,
+           res->cs_test_fail, res->channel_nb, res->rank_nb);
+  }
 
-    case 2:
-      value = strtoll(argv[0], &end_ptr, 0);
-      if ((end_ptr == argv[0]) || (value > STEP_RUN))
+  for (ch = 0; ch < res->channel_nb; ch++)
+  {
+    for (type = 0; type < HAL_DDR_CDD_NB; type++)
+    {
+      for (from = 0; from < res->rank_nb; from++)
       {
-        printf("invalid argument %s\n\r", argv[1]);
-        goto end;
+        for (to = 0; to < res->rank_nb; to++)
+        {
+          if ((from == to) &&
+              ((type == HAL_DDR_CDD_RR) || (type == HAL_DDR_CDD_WW)))
+          {
+            continue;
+          }
+
+          cdd = res->cdd[ch][type][from][to];
+          if (tlm)
+          {
+            snprintf(label, sizeof(label), "%u;%s", pstate, cdd_str[type]);
+            value[0] = ch;
+            value[1] = from;
+            value[2] = to;
+            value[3] = (unsigned long)(long)cdd;
+            DDR_Tlm_Sample("CDD", label, value, 4);
+            continue;
+          }
+
+          printf("  cdd %s channel %u rank %u to %u: %d\n\r",
+                 cdd_str[type], ch, from, to, cdd);
+          printf("CDD;%u;%s;%u;%u;%u;%d\n\r", pstate, cdd_str[type], ch,
+                 from, to, cdd);
+        }
       }
+    }
+  }
 
-      if ((value != STEP_DDR_RESET) && (value <= step))
+  for (from = 0; (res->vref_nb != 0U) && (from < res->rank_nb); from++)
+  {
+    if (tlm)
+    {
+      snprintf(label, sizeof(label), "%u", pstate);
+      value[0] = from;
+      for (i = 0; i < res->vref_nb; i++)
       {
-        printf("invalid target %d:%s, current step is %d:%s\n\r",
-               (int)value, step_str[value], step, step_str[step]);
-        goto end;
+        value[i + 1U] = res->vref[from][i];
       }
-      printf("step to %d:%s\n\r", (int)value, step_str[value]);
-      return (HAL_DDR_InteractStepTypeDef)value;
-  };
+      DDR_Tlm_Sample("VREF", label, value, res->vref_nb + 1U);
+      continue;
+    }
 
-end:
-  return step;
+    printf("  VrefDQ rank %u:", from);
+    for (i = 0; i < res->vref_nb; i++)
+    {
+      printf(" 0x%02x", res->vref[from][i]);
+    }
+    printf("\n\rVREF;%u;%u", pstate, from);
+    for (i = 0; i < res->vref_nb; i++)
+    {
+      printf(";%u", res->vref[from][i]);
+    }
+    printf("\n\r");
+  }
 }
 
-static char argv0[CMD_MAX_LEN / 4] = "\0";
-static char argv1[CMD_MAX_LEN / 4] = "\0";
-static char argv2[CMD_MAX_LEN / 4] = "\0";
-static char argv3[CMD_MAX_LEN / 4] = "\0";
-
-static void do_subcmd(int argc, char *argv[], const subcmd_desc *array,
-                      const int size)
+static void do_training(int argc, char *argv[])
 {
-  int i;
-  int64_t value;
-  int local_argc = argc;
-  uint32_t retcode;
+  HAL_DDR_TrainingResultTypeDef res;
+  unsigned int pstate;
 
-  if (local_argc == 1)
+  if (argc == 1)
   {
-    printf("Please enter a sub command number\n\r\n\r");
-    print_subcmd_usage(array, size);
+    for (pstate = 0;
+         pstate < (unsigned int)static_ddr_config.p_uib.numpstates; pstate++)
+    {
+      if (HAL_DDR_GetTrainingResult(pstate, &res) != HAL_OK)
+      {
+        printf("P%u: no training result (training skipped or restored)\n\r",
+               pstate);
+        cmd_failed = true;
+        continue;
+      }
+
+      training_report(pstate, &res);
+    }
     return;
   }
 
-  /* Check sub command ID */
-  value = string_to_num(argv[0]);
-  if ((value < 0) || (value >= size))
+  if (strcmp(argv[0], "log"))
   {
-    printf("Unknown sub command [%s]\n\r\n\r", argv[0]);
-    print_subcmd_usage(array, size);
+    printf("argument %s invalid\n\r", argv[0]);
+    cmd_failed = true;
     return;
   }
 
-  /*
-   * Test All command is also differently treated, regrding number of
-   * arguments (0, 1, 2). So complete arguments to have a generic API including
-   * number of valid arguments in third position.
-   */
-  if ((array == test) && (array[value].fct == DDR_Test_All))
+  if ((argc == 3) && strcmp(argv[1], "clear"))
   {
-    switch (local_argc - 2)
-    {
-    case 0:
-      argv1[0] = argv2[0] = argv3[0] = '0';
-      argv1[1] = argv2[1] = argv3[1] = '\0';
-      local_argc = array[value].max_args + 2;
-      break;
-    case 1:
-      argv2[0] = argv3[0] = '0';
-      argv2[1] = argv3[1] = '\0';
-      local_argc = array[value].max_args + 2;
-      break;
-    case 2:
-      argv3[0] = '0';
-      argv3[1] = '\0';
-      local_argc = array[value].max_args + 2;
-      break;
-    case 3:
-      local_argc = array[value].max_args + 2;
-      break;
-    default:
-      local_argc = -1;
-      break;
-    }
+    printf("argument %s invalid\n\r", argv[1]);
+    cmd_failed = true;
+    return;
   }
 
-  /* Check number of sub command arguments */
-  if ((uint8_t)(local_argc - 2) != array[value].max_args)
+  if (argc == 3)
   {
-    /* any other cases */
-    printf("Incorrect number of arguments\n\r\n\r");
-    print_single_subcmd_usage(array, value);
+    DDR_Trace_Training_Clear();
     return;
   }
 
-  /* Check argument validity */
-  for (i = 1; i <= (local_argc - 2); i++)
+  DDR_Trace_Training_Dump();
+}
+
+static void do_cache(int argc, char *argv[])
+{
+  if (argc == 2)
   {
-    if (string_to_num(argv[i]) < 0)
+    if (!strcmp(argv[0], "on"))
     {
-      printf("Invalid argument #%d %s\n\r\n\r", i, argv[i]);
-      print_single_subcmd_usage(array, value);
+      (void)DDR_Test_Set_Cache(true);
+    }
+    else if (!strcmp(argv[0], "off"))
+    {
+      (void)DDR_Test_Set_Cache(false);
+    }
+    else
+    {
+      printf("argument %s invalid\n\r", argv[0]);
       return;
     }
   }
 
-  switch (array[value].max_args)
-  {
+  printf("cache = %s\n\r", DDR_Test_Get_Cache() ? "on (write-back)" :
+                                                   "off (non-cacheable)");
+}
+
+static void do_baud(int argc, char *argv[])
+{
+  int64_t value;
+
+  if (argc == 1)
+  {
+    UART_Baudrate_Info();
+    return;
+  }
+
+  value = string_to_num(argv[0]);
+  if ((value <= 0) || (value > UINT32_MAX))
+  {
+    printf("argument %s invalid\n\r", argv[0]);
+    cmd_failed = true;
+    return;
+  }
+
+  if (!UART_Set_Baudrate((uint32_t)value))
+  {
+    cmd_failed = true;
+  }
+}
+
+static void do_seed(int argc, char *argv[])
+{
+  int64_t value;
+
+  if (argc == 2)
+  {
+    value = string_to_num(argv[0]);
+    if (value < 0)
+    {
+      printf("argument %s invalid\n\r", argv[0]);
+      return;
+    }
+
+    DDR_Test_Set_Seed((unsigned long)value);
+  }
+
+  printf("seed = 0x%lx\n\r", DDR_Test_Get_Seed());
+}
+
+static void do_dma(int argc, char *argv[])
+{
+  unsigned long arg[2] = {0, 0};
+  int64_t value;
+  int i;
+
+  for (i = 1; i < argc - 1; i++)
+  {
+    value = string_to_num(argv[i]);
+    if (value < 0)
+    {
+      printf("argument %s invalid\n\r", argv[i]);
+      return;
+    }
+    arg[i - 1] = (unsigned long)value;
+  }
+
+  if (argc == 1)
+  {
+    /* status only */
+  }
+  else if (!strcmp(argv[0], "off") && (argc == 2))
+  {
+    cmd_failed = !DDR_Dma_Stop();
+  }
+  else if (!strcmp(argv[0], "copy"))
+  {
+    cmd_failed = !DDR_Dma_Start(DDR_DMA_COPY, arg[0], arg[1]);
+  }
+  else if (!strcmp(argv[0], "fill"))
+  {
+    cmd_failed = !DDR_Dma_Start(DDR_DMA_FILL, arg[0], arg[1]);
+  }
+  else if (!strcmp(argv[0], "bench"))
+  {
+    cmd_failed = !DDR_Dma_Bench(arg[0], arg[1]);
+  }
+  else
+  {
+    printf("argument %s invalid\n\r", argv[0]);
+    return;
+  }
+
+  DDR_Dma_Status();
+}
+
+static void do_addrmap(int argc, char *argv[])
+{
+  ddr_addrmap_loc loc;
+  int64_t value;
+
+  DDR_AddrMap_Update();
+
+  if (argc == 1)
+  {
+    DDR_AddrMap_Print();
+    DDR_AddrMap_Get_Size(&loc);
+    printf("%lu rank, %lu bg, %lu bank, %lu rows, %lu columns of %lu bytes\n\r",
+           loc.rank, loc.bg, loc.bank, loc.row, loc.col,
+           DDR_AddrMap_Get_Unit());
+    return;
+  }
+
+  value = string_to_num(argv[0]);
+  if ((value < 0) || !DDR_AddrMap_Decode((unsigned long)value, &loc))
+  {
+    printf("argument %s invalid\n\r", argv[0]);
+    return;
+  }
+
+  printf("0x%lx: rank %lu, bg %lu, bank %lu, row 0x%lx, col 0x%lx\n\r",
+         (unsigned long)value, loc.rank, loc.bg, loc.bank, loc.row, loc.col);
+}
+
+static void do_latency(int argc, char *argv[])
+{
+  static const char * const chain_str[] = {
+    [DDR_LAT_ALL] = "all",
+    [DDR_LAT_HIT] = "hit",
+    [DDR_LAT_MISS] = "miss",
+    [DDR_LAT_CONFLICT] = "conflict",
+    [DDR_LAT_RANDOM] = "random",
+  };
+  ddr_lat_chain chain = DDR_LAT_ALL;
+  unsigned long arg[2] = {0, 0};
+  unsigned long stride = 0;
+  int64_t value;
+  int i;
+
+  if (argc > 1)
+  {
+    for (i = 0; i < (int)(sizeof(chain_str) / sizeof(chain_str[0])); i++)
+    {
+      if (!strcmp(argv[0], chain_str[i]))
+      {
+        chain = (ddr_lat_chain)i;
+        break;
+      }
+    }
+
+    if (i == (int)(sizeof(chain_str) / sizeof(chain_str[0])))
+    {
+      value = string_to_num(argv[0]);
+      if (value <= 0)
+      {
+        printf("argument %s invalid\n\r", argv[0]);
+        return;
+      }
+      chain = DDR_LAT_STRIDE;
+      stride = (unsigned long)value;
+    }
+  }
+
+  for (i = 1; i < argc - 1; i++)
+  {
+    value = string_to_num(argv[i]);
+    if (value < 0)
+    {
+      printf("argument %s invalid\n\r", argv[i]);
+      return;
+    }
+    arg[i - 1] = (unsigned long)value;
+  }
+
+  cmd_failed = !DDR_Latency_Run(chain, stride, arg[0], arg[1]);
+}
+
+static bool do_freq(int argc, char *argv[])
+{
+  unsigned long frequency;
+  unsigned long value;
+  char *end_ptr;
+  bool ret_code = true;
+
+  if (argc == 2)
+  {
+    /* DDR freq = PLL2 freq * 2 */
+    value = (strtoll(argv[0], &end_ptr, 0) * 1000) / 2;
+    if (end_ptr == argv[0])
+    {
+      printf("invalid argument %s\n\r", argv[0]);
+      return false;
+    }
+
+    frequency = (unsigned long)HAL_RCCEx_GetPLL2ClockFreq();
+    if (value == frequency)
+    {
+      printf("Same frequency, no change.\n\r");
+      return true;
+    }
+    else if (frequency == 0)
+    {
+      printf("Frequency has never been set before, no change.\n\r");
+      return true;
+    }
+    else
+    {
+      ret_code = pll2_set_rate(value);
+    }
+  }
+
+  frequency = (unsigned long)HAL_RCCEx_GetPLL2ClockFreq();
+  printf("DDRPHY = %ld kHz\n\r", (2 * frequency) / 1000);
+
+  return ret_code;
+}
+
+static void do_param(HAL_DDR_InteractStepTypeDef step, int argc, char *argv[])
+{
+  switch (argc)
+  {
+  case 1:
+    HAL_DDR_Dump_Param(&static_ddr_config, NULL);
+    break;
+  case 2:
+    /* the names are searched without case */
+    if (HAL_DDR_Dump_Param(&static_ddr_config, argv[0]) != HAL_OK)
+    {
+      printf("invalid argument %s\n\r", argv[0]);
+    }
+    break;
+  case 3:
+    if (!check_step(step, STEP_DDR_RESET))
+    {
+      return;
+    }
+    HAL_DDR_Edit_Param(&static_ddr_config, argv[0], argv[1]);
+    break;
+  }
+}
+
+static void do_print(int argc, char * const argv[])
+{
+  switch (argc)
+  {
+    case 1:
+      (void)dump_reg(NULL, false);
+      break;
+    case 2:
+      /* the names are searched without case */
+      if (dump_reg(argv[0], false) != HAL_OK)
+      {
+        printf("invalid argument %s\n\r", argv[0]);
+      }
+      break;
+  }
+}
+
+static HAL_DDR_InteractStepTypeDef do_step(HAL_DDR_InteractStepTypeDef step,
+                                           int argc, char *argv[])
+{
+  int i;
+  unsigned long value;
+  char *end_ptr;
+
+  switch (argc)
+  {
+    case 1:
+      for (i = 0; i <= STEP_RUN; i++)
+      {
+        printf("%d:%s\n\r", i, step_str[i]);
+      }
+      break;
+
+    case 2:
+      value = strtoll(argv[0], &end_ptr, 0);
+      if ((end_ptr == argv[0]) || (value > STEP_RUN))
+      {
+        printf("invalid argument %s\n\r", argv[1]);
+        goto end;
+      }
+
+      if ((value != STEP_DDR_RESET) && (value <= step))
+      {
+        printf("invalid target %d:%s, current step is %d:%s\n\r",
+               (int)value, step_str[value], step, step_str[step]);
+        goto end;
+      }
+      printf("step to %d:%s\n\r", (int)value, step_str[value]);
+      return (HAL_DDR_InteractStepTypeDef)value;
+  };
+
+end:
+  return step;
+}
+
+static char argv0[CMD_MAX_LEN / 4] = "\0";
+static char argv1[CMD_MAX_LEN / 4] = "\0";
+static char argv2[CMD_MAX_LEN / 4] = "\0";
+static char argv3[CMD_MAX_LEN / 4] = "\0";
+
+static void do_subcmd(int argc, char *argv[], const subcmd_desc *array,
+                      const int size)
+{
+  int i;
+  int64_t value;
+  int local_argc = argc;
+  unsigned long arg[CMD_MAX_ARG];
+  uint32_t retcode;
+  ddr_test_stats start = {0, 0};
+  uint64_t ticks;
+
+  /* cleared when the test passes */
+  cmd_failed = true;
+
+  if (local_argc == 1)
+  {
+    printf("Please enter a sub command number\n\r\n\r");
+    print_subcmd_usage(array, size);
+    return;
+  }
+
+  /* Check sub command ID */
+  value = string_to_num(argv[0]);
+  if ((value < 0) || (value >= size))
+  {
+    printf("Unknown sub command [%s]\n\r\n\r", argv[0]);
+    print_subcmd_usage(array, size);
+    return;
+  }
+
+  /*
+   * Test All command is also differently treated, regrding number of
+   * arguments (0, 1, 2). So complete arguments to have a generic API including
+   * number of valid arguments in third position.
+   */
+  if ((array == test) && (array[value].fct == DDR_Test_All))
+  {
+    switch (local_argc - 2)
+    {
     case 0:
-      retcode = array[value].fct();
+      argv1[0] = argv2[0] = argv3[0] = '0';
+      argv1[1] = argv2[1] = argv3[1] = '\0';
+      local_argc = array[value].max_args + 2;
       break;
     case 1:
-      retcode = array[value].fct((uint32_t)string_to_num(argv[1]));
+      argv2[0] = argv3[0] = '0';
+      argv2[1] = argv3[1] = '\0';
+      local_argc = array[value].max_args + 2;
       break;
     case 2:
-      retcode = array[value].fct((uint32_t)string_to_num(argv[1]),
-                                (uint32_t)string_to_num(argv[2]));
+      argv3[0] = '0';
+      argv3[1] = '\0';
+      local_argc = array[value].max_args + 2;
       break;
     case 3:
-      retcode = array[value].fct((uint32_t)string_to_num(argv[1]),
-                                (uint32_t)string_to_num(argv[2]),
-                                (uint32_t)string_to_num(argv[3]));
+      local_argc = array[value].max_args + 2;
       break;
     default:
-      printf("Number of arguments not supported\n\r");
-      retcode = 0XFFFFFFFF;
+      local_argc = -1;
       break;
+    }
+  }
+
+  /* Check number of sub command arguments */
+  if ((uint8_t)(local_argc - 2) != array[value].max_args)
+  {
+    /* any other cases */
+    printf("Incorrect number of arguments\n\r\n\r");
+    print_single_subcmd_usage(array, value);
+    return;
+  }
+
+  /* Check argument validity */
+  for (i = 1; i <= (local_argc - 2); i++)
+  {
+    if (string_to_num(argv[i]) < 0)
+    {
+      printf("Invalid argument #%d %s\n\r\n\r", i, argv[i]);
+      print_single_subcmd_usage(array, value);
+      return;
+    }
+  }
+
+  DDR_Test_Stats_Reset();
+  DDR_Test_Errors_Reset();
+  ticks = timer_get_count();
+
+  for (i = 0; (i < array[value].max_args) && (i < CMD_MAX_ARG); i++)
+  {
+    arg[i] = (uint32_t)string_to_num(argv[i + 1]);
+  }
+
+  retcode = test_run(value, arg);
+
+  ticks = timer_get_count() - ticks;
+
+  /* Test All reports the errors of each test */
+  if ((array == test) && (array[value].fct != DDR_Test_All) &&
+      (DDR_Test_Errors_Report() != 0U) && (retcode == 0U))
+  {
+    retcode = DDR_TEST_ERRORS_ACCUMULATED;
   }
 
   if (retcode != 0)
   {
     printf("%s failed [%d]\n\r", array[value].name, retcode);
-    return;
   }
-
+  else
+  {
     printf("Result: Pass [%s]\n\r", array[value].name);
+    cmd_failed = false;
+  }
+
+  if (array == test)
+  {
+    print_test_stats(value, retcode, ticks, &start);
+  }
 }
 
-bool HAL_DDR_Interactive(HAL_DDR_InteractStepTypeDef step)
+static bool execute_line(HAL_DDR_InteractStepTypeDef step, char *line,
+                         int *next_step)
 {
-  char buffer[CMD_MAX_LEN];
   char *argv[CMD_MAX_ARG + 1] = {argv0, argv1, argv2, argv3}; /* NULL terminated */
   int argc;
   int cmd;
-  static int next_step = -1;
-
-  if ((next_step < 0) && (step == STEP_DDR_RESET))
-  {
-    next_step = STEP_DDR_RESET;
-  }
 
-//  printf("** step %d ** %s / %d\n\r", step, step_str[step], next_step);
-
-  if (next_step < 0)
+  argc = parse_entry_string(line, strlen(line), &cmd, argv);
+  if (argc < 0)
   {
+    printf("Error [%d]\n\r", argc);
     return false;
   }
-
-  if (step > STEP_RUN)
+  else if (argc == 0)
   {
-    printf("** step %d ** INVALID\n\r", step);
-    return false;
+    return true;
   }
 
-  printf("%d:%s\n\r", step, step_str[step]);
+  cmd_failed = false;
+  execute_command(step, cmd, argc, argv, next_step);
 
-  if (next_step > step)
+  return !cmd_failed;
+}
+
+/* offset of the '}' closing the block opened before text[pos], or len */
+static size_t script_block_end(const char *text, size_t len, size_t pos)
+{
+  int depth = 1;
+
+  for (; pos < len; pos++)
   {
-    return false;
+    if (text[pos] == '{')
+    {
+      depth++;
+    }
+    else if ((text[pos] == '}') && (--depth == 0))
+    {
+      break;
+    }
   }
 
-  while (next_step == step)
+  return pos;
+}
+
+/*
+ * Execute the commands of text[0..len[, separated by ';' or end of line;
+ * "repeat <n> { ... }" executes the block n times, '#' starts a comment up to
+ * the end of line, up to SCRIPT_MAX_DEPTH nested blocks ('depth' of text).
+ * Return false when the execution is stopped: on the first failing command if
+ * 'stop', on syntax error or when the step changes.
+ */
+static bool script_exec(HAL_DDR_InteractStepTypeDef step, const char *text,
+                        size_t len, unsigned int depth, bool stop,
+                        int *next_step)
+{
+  char line[CMD_MAX_LEN];
+  size_t pos = 0;
+  size_t start;
+  size_t end;
+  unsigned long nb;
+  unsigned long i;
+  char *end_ptr;
+
+  while (pos < len)
   {
-    get_entry_string(buffer);
+    if ((text[pos] == ' ') || (text[pos] == ';') ||
+        (text[pos] == '\r') || (text[pos] == '\n'))
+    {
+      pos++;
+      continue;
+    }
 
-    argc = parse_entry_string(buffer, strlen(buffer), &cmd, argv);
-    if (argc < 0)
+    if (text[pos] == '#')
     {
-      printf("Error [%d]\n\r", argc);
+      while ((pos < len) && (text[pos] != '\n'))
+      {
+        pos++;
+      }
       continue;
     }
-    else if (argc == 0)
+
+    start = pos;
+    while ((pos < len) && (text[pos] != ';') && (text[pos] != '\r') &&
+           (text[pos] != '\n') && (text[pos] != '{') && (text[pos] != '}'))
+    {
+      pos++;
+    }
+
+    if ((pos - start) >= CMD_MAX_LEN)
+    {
+      printf("script: command too long\n\r");
+      return false;
+    }
+    memcpy(line, &text[start], pos - start);
+    line[pos - start] = '\0';
+
+    if ((pos < len) && (text[pos] == '}'))
+    {
+      printf("script: unexpected '}'\n\r");
+      return false;
+    }
+
+    if ((pos < len) && (text[pos] == '{'))
     {
+      if (strncmp(line, "repeat ", 7) != 0)
+      {
+        printf("script: '{' without repeat\n\r");
+        return false;
+      }
+
+      nb = strtoul(&line[7], &end_ptr, 0);
+      while (*end_ptr == ' ')
+      {
+        end_ptr++;
+      }
+      end = script_block_end(text, len, pos + 1);
+      if ((end_ptr == &line[7]) || (*end_ptr != '\0') || (end == len))
+      {
+        printf("script: invalid repeat block\n\r");
+        return false;
+      }
+
+      if (depth >= SCRIPT_MAX_DEPTH)
+      {
+        printf("script: more than %d nested repeat blocks\n\r",
+               SCRIPT_MAX_DEPTH);
+        return false;
+      }
+
+      for (i = 0; i < nb; i++)
+      {
+        if (!script_exec(step, &text[pos + 1], end - pos - 1, depth + 1,
+                         stop, next_step))
+        {
+          return false;
+        }
+      }
+
+      pos = end + 1;
       continue;
     }
 
-    switch (cmd)
+    if (!execute_line(step, line, next_step) && stop)
     {
-    case DDR_CMD_HELP:
-      print_usage();
-      break;
+      printf("script: stopped on '%s'\n\r", line);
+      return false;
+    }
 
-    case DDR_CMD_TEST_HELP:
-      print_subcmd_usage(test, test_nb);
-      break;
+    if (*next_step != (int)step)
+    {
+      if (pos < len)
+      {
+        printf("script: stopped on step change\n\r");
+      }
+      return false;
+    }
+  }
 
-    case DDR_CMD_INFO:
-      do_info(step, argc, argv);
-      break;
+  return true;
+}
 
-    case DDR_CMD_FREQ:
-      do_freq(argc, argv);
-      if ((argc == 2) && (step > STEP_CTL_INIT))
+/*
+ * Receive a script without echo until a line "end": the block can be pasted
+ * in the terminal or sent as a file.
+ */
+static void script_load(void)
+{
+  size_t line = 0;
+  size_t nb_line = 0;
+  bool overflow = false;
+  char c;
+
+  printf("script: send the commands, terminated by a line \"end\"\n\r");
+
+  script_len = 0;
+  while (1)
+  {
+    c = (char)Serial_Scanf(255);
+    if ((c != '\r') && (c != '\n'))
+    {
+      if (script_len < sizeof(script_buf) - 1)
       {
-        printf("### Please update PLL settings and DDR timings ###\n\r");
-        printf("### in your project. Then rebuild and restart. ###\n\r");
+        script_buf[script_len++] = c;
       }
-      break;
+      else
+      {
+        overflow = true;
+      }
+      continue;
+    }
 
-    case DDR_CMD_RESET:
-      WRITE_REG(RCC->GRSTCSETR, 0x1U);
-      break;
+    /* end of line: skip the empty ones */
+    if (script_len == line)
+    {
+      continue;
+    }
 
-    case DDR_CMD_PARAM:
-      do_param(step, argc, argv);
+    if ((script_len - line == 3) && !strncmp(&script_buf[line], "end", 3))
+    {
+      script_len = line;
       break;
+    }
 
-    case DDR_CMD_PRINT:
-      do_print(argc, argv);
-      break;
+    script_buf[script_len++] = '\n';
+    line = script_len;
+    nb_line++;
+  }
 
-    case DDR_CMD_EDIT:
-      HAL_DDR_Edit_Reg(argv0, argv1);
-      break;
+  if (overflow)
+  {
+    printf("script: too long (max %d bytes), discarded\n\r",
+           (int)sizeof(script_buf) - 1);
+    script_len = 0;
+  }
+  else
+  {
+    printf("script: %d lines, %d bytes\n\r", (int)nb_line, (int)script_len);
+  }
+  script_buf[script_len] = '\0';
+}
 
-    case DDR_CMD_SAVE:
-      HAL_DDR_Dump_Reg(NULL, true);
-      break;
+static void do_script(HAL_DDR_InteractStepTypeDef step, int argc,
+                      char *argv[], int *next_step)
+{
+  bool stop = true;
+  size_t i;
 
-    case DDR_CMD_GO:
-      next_step = STEP_RUN;
-      printf("### Exit DDR INTERACTIVE mode. Please RESET the BOARD ###\n\r");
-      break;
+  if (script_running)
+  {
+    printf("script: not allowed in a script\n\r");
+    cmd_failed = true;
+    return;
+  }
+
+  if (argc == 3)
+  {
+    if (!strcmp(argv[1], "continue"))
+    {
+      stop = false;
+    }
+    else if (strcmp(argv[1], "stop"))
+    {
+      printf("argument %s invalid\n\r", argv[1]);
+      cmd_failed = true;
+      return;
+    }
+  }
 
-    case DDR_CMD_NEXT:
-      next_step = step + 1;
-      if (next_step == STEP_RUN)
+  if (!strcmp(argv[0], "load") && (argc == 2))
+  {
+    script_load();
+  }
+  else if (!strcmp(argv[0], "list") && (argc == 2))
+  {
+    for (i = 0; i < script_len; i++)
+    {
+      if (script_buf[i] == '\n')
+      {
+        printf("\n\r");
+      }
+      else
       {
-        printf("### Exit DDR INTERACTIVE mode. Please RESET the BOARD ###\n\r");
+        printf("%c", script_buf[i]);
       }
+    }
+  }
+  else if (!strcmp(argv[0], "run"))
+  {
+    script_running = true;
+    cmd_failed = !script_exec(step, script_buf, script_len, 0, stop,
+                              next_step);
+    script_running = false;
+    printf("script: %s\n\r", cmd_failed ? "stopped" : "done");
+  }
+  else
+  {
+    printf("argument %s invalid\n\r", argv[0]);
+    cmd_failed = true;
+  }
+}
+
+static void execute_command(HAL_DDR_InteractStepTypeDef step, int cmd,
+                            int argc, char *argv[], int *next_step)
+{
+  switch (cmd)
+  {
+  case DDR_CMD_HELP:
+    print_usage();
+    break;
+
+  case DDR_CMD_TEST_HELP:
+    print_subcmd_usage(test, test_nb);
+    break;
+
+  case DDR_CMD_INFO:
+    do_info(step, argc, argv);
+    break;
+
+  case DDR_CMD_FREQ:
+    do_freq(argc, argv);
+    if ((argc == 2) && (step > STEP_CTL_INIT))
+    {
+      printf("### Please update PLL settings and DDR timings ###\n\r");
+      printf("### in your project. Then rebuild and restart. ###\n\r");
+    }
+    break;
+
+  case DDR_CMD_RESET:
+    UART_Tx_Flush();
+    WRITE_REG(RCC->GRSTCSETR, 0x1U);
+    break;
+
+  case DDR_CMD_PARAM:
+    do_param(step, argc, argv);
+    break;
+
+  case DDR_CMD_PRINT:
+    do_print(argc, argv);
+    break;
+
+  case DDR_CMD_EDIT:
+    HAL_DDR_Edit_Reg(argv0, argv1);
+    break;
+
+  case DDR_CMD_SAVE:
+    (void)dump_reg(NULL, true);
+    break;
+
+  case DDR_CMD_GO:
+    *next_step = STEP_RUN;
+    printf("### Exit DDR INTERACTIVE mode. Please RESET the BOARD ###\n\r");
+    break;
+
+  case DDR_CMD_NEXT:
+    *next_step = step + 1;
+    if (*next_step == STEP_RUN)
+    {
+      printf("### Exit DDR INTERACTIVE mode. Please RESET the BOARD ###\n\r");
+    }
+    break;
+
+  case DDR_CMD_STEP:
+    *next_step = do_step(step, argc, argv);
+    break;
+
+  case DDR_CMD_TEST:
+    if (!check_step(step, STEP_DDR_READY))
+    {
+      cmd_failed = true;
       break;
+    }
+    do_subcmd(argc, argv, test, test_nb);
+    break;
+
+  case DDR_CMD_ERROR:
+    do_error(argc, argv);
+    break;
+
+  case DDR_CMD_SMP:
+    do_smp(argc, argv);
+    break;
+
+  case DDR_CMD_TLM:
+    do_tlm(argc, argv);
+    break;
+
+  case DDR_CMD_BAUD:
+    do_baud(argc, argv);
+    break;
+
+  case DDR_CMD_TRACE:
+    do_trace(argc, argv);
+    break;
+
+  case DDR_CMD_TRAINING:
+    do_training(argc, argv);
+    break;
+
+  case DDR_CMD_CACHE:
+    do_cache(argc, argv);
+    break;
+
+  case DDR_CMD_SEED:
+    do_seed(argc, argv);
+    break;
 
-    case DDR_CMD_STEP:
-      next_step = do_step(step, argc, argv);
+  case DDR_CMD_DMA:
+    if (!check_step(step, STEP_DDR_READY))
+    {
+      cmd_failed = true;
       break;
+    }
+    do_dma(argc, argv);
+    break;
 
-    case DDR_CMD_TEST:
-      if (!check_step(step, STEP_DDR_READY))
-      {
-        continue;
-      }
-      do_subcmd(argc, argv, test, test_nb);
+  case DDR_CMD_ADDRMAP:
+    if (step < STEP_CTL_INIT)
+    {
+      printf("invalid step %d:%s, DDRC not initialized\n\r",
+             step, step_str[step]);
+      cmd_failed = true;
       break;
+    }
+    do_addrmap(argc, argv);
+    break;
 
-    default:
+  case DDR_CMD_SCRIPT:
+    do_script(step, argc, argv, next_step);
+    break;
+
+  case DDR_CMD_LATENCY:
+    if (!check_step(step, STEP_DDR_READY))
+    {
+      cmd_failed = true;
       break;
     }
+    do_latency(argc, argv);
+    break;
+
+  default:
+    break;
+  }
+}
+
+bool HAL_DDR_Interactive(HAL_DDR_InteractStepTypeDef step)
+{
+  char buffer[CMD_MAX_LEN];
+  static int next_step = -1;
+
+  if ((next_step < 0) && (step == STEP_DDR_RESET))
+  {
+    next_step = STEP_DDR_RESET;
+  }
+
+//  printf("** step %d ** %s / %d\n\r", step, step_str[step], next_step);
+
+  if (next_step < 0)
+  {
+    return false;
+  }
+
+  if (step > STEP_RUN)
+  {
+    printf("** step %d ** INVALID\n\r", step);
+    return false;
+  }
+
+  printf("%d:%s\n\r", step, step_str[step]);
+
+  if (next_step > step)
+  {
+    return false;
+  }
+
+  while (next_step == step)
+  {
+    get_entry_string(buffer);
+
+    /* one or several commands, stop at the first failure */
+    (void)script_exec(step, buffer, strlen(buffer), 0, true, &next_step);
   }
 
   return next_step == STEP_DDR_RESET;
@@ -0,0 +1,522 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_dma.c
+  * @author  MCD Application Team
+  * @brief   HPDMA traffic generator: circular linked lists copy or fill a DDR
+  *          region in background, while the CPU tests run on other regions,
+  *          and DMA-only bandwidth benchmark.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_device_hal.h"
+
+#include <stdio.h>
+#include "ddr_tests.h"
+#include "ddr_tool_dma.h"
+#include "system_time.h"
+#include "stm32mp_util_ddr_conf.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define DDR_DMA_CHANNEL         HPDMA1_Channel15
+/* transfer size of one node, limited by the 16 bits of BNDT */
+#define DDR_DMA_BLOCK_SIZE      0x8000UL
+#define DDR_DMA_NODE_NB         64
+/* size written by one execution of the linked list */
+#define DDR_DMA_LIST_SIZE       (DDR_DMA_NODE_NB * DDR_DMA_BLOCK_SIZE)
+#define DDR_DMA_DFLT_SIZE       0x100000UL
+/* each half of a copy is a multiple of the burst: 16 x 64 bits */
+#define DDR_DMA_BURST           16
+#define DDR_DMA_ALIGN           256UL
+/* the HPDMA addresses are on 32 bits */
+#define DDR_DMA_ADDR_END        0x100000000UL
+#define DDR_DMA_PATTERN         0xA5A5A5A55A5A5A5AUL
+#define DDR_DMA_BENCH_LOOP      32
+#define DDR_DMA_TIMEOUT         1000000 /* us */
+#define DDR_DMA_ERROR_FLAGS     (DMA_FLAG_DTE | DMA_FLAG_ULE | DMA_FLAG_USE)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static DMA_HandleTypeDef dma_handle;
+static DMA_QListTypeDef dma_queue;
+
+/*
+ * The nodes are addressed by a 16-bit offset from the base of the linked list
+ * (CLBAR): they are aligned to stay in the same 64KB page.
+ */
+static DMA_NodeTypeDef dma_node[DDR_DMA_NODE_NB] __attribute__((aligned(4096)));
+
+/* source of the fill, read at a fixed address */
+static uint64_t dma_pattern = DDR_DMA_PATTERN;
+
+static ddr_dma_mode dma_mode;
+static unsigned long dma_size;
+static unsigned long dma_addr;
+static bool dma_ready;
+
+static const char * const dma_mode_str[] = {
+  [DDR_DMA_OFF] = "off",
+  [DDR_DMA_COPY] = "copy",
+  [DDR_DMA_FILL] = "fill",
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/*
+ * Check the DMA region, the default region is at the end of the DDR reachable
+ * by the HPDMA, away from the default address of the CPU tests.
+ */
+static bool dma_check_region(unsigned long max, unsigned long *size,
+                             unsigned long *addr)
+{
+  unsigned long end = (unsigned long)DDR_MEM_BASE +
+                      (unsigned long)DDR_MEM_SIZE;
+
+  if (end > DDR_DMA_ADDR_END)
+  {
+    end = DDR_DMA_ADDR_END;
+  }
+
+  if (*size == 0U)
+  {
+    *size = DDR_DMA_DFLT_SIZE;
+  }
+
+  if ((*size > max) || ((*size & (DDR_DMA_ALIGN - 1)) != 0U))
+  {
+    printf("size 0x%lx invalid: multiple of 0x%lx up to 0x%lx\n\r",
+           *size, DDR_DMA_ALIGN, max);
+    return false;
+  }
+
+  if (*addr == 0U)
+  {
+    *addr = end - *size;
+  }
+
+  if ((*addr < (unsigned long)DDR_MEM_BASE) || ((*addr & 0x7U) != 0U) ||
+      (*addr > end - *size))
+  {
+    printf("address 0x%lx invalid: 8 bytes aligned, DDR below 0x%lx\n\r",
+           *addr, DDR_DMA_ADDR_END);
+    return false;
+  }
+
+  return true;
+}
+
+static bool dma_setup(void)
+{
+  if (dma_ready)
+  {
+    return true;
+  }
+
+  __HAL_RCC_HPDMA1_CLK_ENABLE();
+
+  dma_handle.Instance = DDR_DMA_CHANNEL;
+  dma_handle.InitLinkedList.Priority = DMA_HIGH_PRIORITY;
+  dma_handle.InitLinkedList.LinkStepMode = DMA_LSM_FULL_EXECUTION;
+  dma_handle.InitLinkedList.LinkAllocatedPort = DMA_LINK_ALLOCATED_PORT1;
+  dma_handle.InitLinkedList.TransferEventMode = DMA_TCEM_LAST_LL_ITEM_TRANSFER;
+  dma_handle.InitLinkedList.LinkedListMode = DMA_LINKEDLIST_NORMAL;
+
+  if (HAL_DMAEx_List_Init(&dma_handle) != HAL_OK)
+  {
+    printf("DMA init failed\n\r");
+    return false;
+  }
+
+#if defined CORTEX_IN_SECURE_STATE
+  if (HAL_DMA_ConfigChannelAttributes(&dma_handle,
+                                      DMA_CHANNEL_PRIV | DMA_CHANNEL_SEC |
+                                      DMA_CHANNEL_SRC_SEC |
+                                      DMA_CHANNEL_DEST_SEC) != HAL_OK)
+  {
+    printf("DMA attributes failed\n\r");
+    return false;
+  }
+#endif /* CORTEX_IN_SECURE_STATE */
+
+  dma_ready = true;
+
+  return true;
+}
+
+/*
+ * Build the linked list of the region: the copy moves the 1st half of the
+ * region to the 2nd half, the fill writes the whole region with dma_pattern.
+ */
+static bool dma_build(ddr_dma_mode mode, unsigned long size,
+                      unsigned long addr, uint32_t list_mode)
+{
+  DMA_NodeConfTypeDef conf = {0};
+  unsigned long len;
+  unsigned long src;
+  unsigned long dst;
+  unsigned long offset = 0;
+  int i = 0;
+
+  (void)HAL_DMAEx_List_UnLinkQ(&dma_handle);
+  if (HAL_DMAEx_List_ResetQ(&dma_queue) != HAL_OK)
+  {
+    printf("DMA queue reset failed\n\r");
+    return false;
+  }
+
+  if (mode == DDR_DMA_COPY)
+  {
+    len = size / 2;
+    src = addr;
+    dst = addr + len;
+  }
+  else
+  {
+    len = size;
+    src = (unsigned long)&dma_pattern;
+    dst = addr;
+  }
+
+  conf.NodeType = DMA_HPDMA_LINEAR_NODE;
+  conf.Init.Request = DMA_REQUEST_SW;
+  conf.Init.BlkHWRequest = DMA_BREQ_SINGLE_BURST;
+  conf.Init.Direction = DMA_MEMORY_TO_MEMORY;
+  conf.Init.SrcInc = (mode == DDR_DMA_COPY) ? DMA_SINC_INCREMENTED :
+                                              DMA_SINC_FIXED;
+  conf.Init.DestInc = DMA_DINC_INCREMENTED;
+  conf.Init.SrcDataWidth = DMA_SRC_DATAWIDTH_DOUBLEWORD;
+  conf.Init.DestDataWidth = DMA_DEST_DATAWIDTH_DOUBLEWORD;
+  conf.Init.SrcBurstLength = (mode == DDR_DMA_COPY) ? DDR_DMA_BURST : 1;
+  conf.Init.DestBurstLength = DDR_DMA_BURST;
+  conf.Init.TransferAllocatedPort = DMA_SRC_ALLOCATED_PORT0 |
+                                    DMA_DEST_ALLOCATED_PORT1;
+  conf.Init.TransferEventMode = DMA_TCEM_LAST_LL_ITEM_TRANSFER;
+  conf.Init.Mode = DMA_NORMAL;
+  conf.DataHandlingConfig.DataExchange = DMA_EXCHANGE_NONE;
+  conf.DataHandlingConfig.DataAlignment = DMA_DATA_RIGHTALIGN_ZEROPADDED;
+  conf.TriggerConfig.TriggerPolarity = DMA_TRIG_POLARITY_MASKED;
+#if defined CORTEX_IN_SECURE_STATE
+  conf.SrcSecure = DMA_CHANNEL_SRC_SEC;
+  conf.DestSecure = DMA_CHANNEL_DEST_SEC;
+#endif /* CORTEX_IN_SECURE_STATE */
+
+  while (offset < len)
+  {
+    conf.DataSize = (uint32_t)(((len - offset) > DDR_DMA_BLOCK_SIZE) ?
+                               DDR_DMA_BLOCK_SIZE : (len - offset));
+    conf.SrcAddress = (uint32_t)((mode == DDR_DMA_COPY) ? src + offset : src);
+    conf.DstAddress = (uint32_t)(dst + offset);
+
+    if ((HAL_DMAEx_List_BuildNode(&conf, &dma_node[i]) != HAL_OK) ||
+        (HAL_DMAEx_List_InsertNode_Tail(&dma_queue, &dma_node[i]) != HAL_OK))
+    {
+      printf("DMA node %d failed\n\r", i);
+      return false;
+    }
+
+    offset += conf.DataSize;
+    i++;
+  }
+
+  if ((list_mode == DMA_LINKEDLIST_CIRCULAR) &&
+      (HAL_DMAEx_List_SetCircularMode(&dma_queue) != HAL_OK))
+  {
+    printf("DMA circular mode failed\n\r");
+    return false;
+  }
+
+  dma_handle.InitLinkedList.LinkedListMode = list_mode;
+  if ((HAL_DMAEx_List_Init(&dma_handle) != HAL_OK) ||
+      (HAL_DMAEx_List_LinkQ(&dma_handle, &dma_queue) != HAL_OK))
+  {
+    printf("DMA link failed\n\r");
+    return false;
+  }
+
+  return true;
+}
+
+/* Execute once the linked list built in normal mode */
+static bool dma_run(void)
+{
+  uint64_t timeout;
+
+  if (HAL_DMAEx_List_Start(&dma_handle) != HAL_OK)
+  {
+    printf("DMA start failed\n\r");
+    return false;
+  }
+
+  /* HAL_GetTick() is not incremented: timeout based on the generic timer */
+  timeout = timer_get_count() +
+            ((uint64_t)timer_get_freq() * DDR_DMA_TIMEOUT) / 1000000U;
+  while (__HAL_DMA_GET_FLAG(&dma_handle, DMA_FLAG_IDLE) == 0U)
+  {
+    if (timer_get_count() > timeout)
+    {
+      (void)HAL_DMA_Abort(&dma_handle);
+      printf("DMA timeout\n\r");
+      return false;
+    }
+  }
+
+  if (HAL_DMA_PollForTransfer(&dma_handle, HAL_DMA_FULL_TRANSFER, 0) != HAL_OK)
+  {
+    printf("DMA transfer error 0x%x\n\r", (unsigned int)dma_handle.ErrorCode);
+    return false;
+  }
+
+  return true;
+}
+
+/* Source of the copy: each word is its address xor the pattern */
+static void dma_prepare(ddr_dma_mode mode, unsigned long size,
+                        unsigned long addr)
+{
+  volatile uint64_t *src = (volatile uint64_t *)addr;
+  unsigned long i;
+
+  if (mode != DDR_DMA_COPY)
+  {
+    return;
+  }
+
+  for (i = 0; i < size / 2 / sizeof(uint64_t); i++)
+  {
+    src[i] = (uint64_t)&src[i] ^ DDR_DMA_PATTERN;
+  }
+
+  /* the HPDMA is not coherent with the A35 caches */
+  if (DDR_Test_Get_Cache())
+  {
+    DDR_Test_Cache_Flush();
+  }
+}
+
+/* Check the destination written by the HPDMA */
+static bool dma_check(ddr_dma_mode mode, unsigned long size,
+                      unsigned long addr)
+{
+  volatile uint64_t *src = (volatile uint64_t *)addr;
+  volatile uint64_t *dst = (volatile uint64_t *)addr;
+  unsigned long nb = size / sizeof(uint64_t);
+  uint64_t expected;
+  unsigned long i;
+
+  if (DDR_Test_Get_Cache())
+  {
+    DDR_Test_Cache_Flush();
+  }
+
+  if (mode == DDR_DMA_COPY)
+  {
+    nb /= 2;
+    dst = src + nb;
+  }
+
+  for (i = 0; i < nb; i++)
+  {
+    expected = (mode == DDR_DMA_COPY) ? src[i] : DDR_DMA_PATTERN;
+    if (dst[i] != expected)
+    {
+      printf("DMA %s KO at 0x%lx: 0x%016lx != 0x%016lx\n\r",
+             dma_mode_str[mode], (unsigned long)&dst[i],
+             (unsigned long)dst[i], (unsigned long)expected);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void dma_print_rate(const char *name, unsigned long read,
+                           unsigned long written, uint64_t ticks)
+{
+  unsigned long elapsed_us = (unsigned long)timer_ticks_to_us(ticks);
+  unsigned long bandwidth = 0;
+
+  /* bytes per microsecond = MB/s */
+  if (elapsed_us != 0U)
+  {
+    bandwidth = (read + written) / elapsed_us;
+  }
+
+  printf("  DMA %s: read %lu bytes, written %lu bytes in %lu.%06lu s"
+         " => %lu MB/s\n\r", name, read, written,
+         elapsed_us / 1000000, elapsed_us % 1000000, bandwidth);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+* @brief Start the background DMA traffic on a DDR region: the linked list is
+*   executed and checked once, then restarted in circular mode.
+*   The traffic running before is stopped.
+* @param mode: DDR_DMA_COPY or DDR_DMA_FILL
+* @param size: size of the region, 0 = default size
+* @param addr: address of the region, 0 = end of the DDR
+* @retval true when the traffic is running
+*/
+bool DDR_Dma_Start(ddr_dma_mode mode, unsigned long size, unsigned long addr)
+{
+  unsigned long max = (mode == DDR_DMA_COPY) ? 2 * DDR_DMA_LIST_SIZE :
+                                               DDR_DMA_LIST_SIZE;
+
+  if (!DDR_Dma_Stop() || !dma_check_region(max, &size, &addr) ||
+      !dma_setup())
+  {
+    return false;
+  }
+
+  dma_prepare(mode, size, addr);
+
+  if (!dma_build(mode, size, addr, DMA_LINKEDLIST_NORMAL) || !dma_run() ||
+      !dma_check(mode, size, addr))
+  {
+    return false;
+  }
+
+  if (!dma_build(mode, size, addr, DMA_LINKEDLIST_CIRCULAR) ||
+      (HAL_DMAEx_List_Start(&dma_handle) != HAL_OK))
+  {
+    printf("DMA start failed\n\r");
+    return false;
+  }
+
+  dma_mode = mode;
+  dma_size = size;
+  dma_addr = addr;
+  DDR_Test_Set_Reserved(addr, size);
+
+  return true;
+}
+
+/**
+* @brief Stop the background DMA traffic and check the DMA region.
+* @retval false when a DMA error or a data error is detected
+*/
+bool DDR_Dma_Stop(void)
+{
+  uint32_t flags;
+  bool ret = true;
+
+  if (dma_mode == DDR_DMA_OFF)
+  {
+    return true;
+  }
+
+  /* the flags are cleared by the abort */
+  flags = dma_handle.Instance->CSR & DDR_DMA_ERROR_FLAGS;
+  (void)HAL_DMA_Abort(&dma_handle);
+
+  if (flags != 0U)
+  {
+    printf("DMA error flags 0x%x\n\r", (unsigned int)flags);
+    ret = false;
+  }
+
+  if (!dma_check(dma_mode, dma_size, dma_addr))
+  {
+    ret = false;
+  }
+
+  dma_mode = DDR_DMA_OFF;
+  DDR_Test_Set_Reserved(0, 0);
+
+  return ret;
+}
+
+/**
+* @brief Display the background DMA traffic.
+* @retval None
+*/
+void DDR_Dma_Status(void)
+{
+  uint32_t flags;
+
+  if (dma_mode == DDR_DMA_OFF)
+  {
+    printf("dma = off\n\r");
+    return;
+  }
+
+  printf("dma = %s 0x%lx bytes @ 0x%lx\n\r", dma_mode_str[dma_mode],
+         dma_size, dma_addr);
+
+  flags = dma_handle.Instance->CSR & DDR_DMA_ERROR_FLAGS;
+  if (flags != 0U)
+  {
+    printf("DMA error flags 0x%x\n\r", (unsigned int)flags);
+  }
+}
+
+/**
+* @brief DMA-only bandwidth benchmark on a DDR region: copy of the 1st half to
+*   the 2nd half then fill of the whole region, each executed
+*   DDR_DMA_BENCH_LOOP times.
+* @param size: size of the region, 0 = default size
+* @param addr: address of the region, 0 = end of the DDR
+* @retval true when the benchmark is executed without error
+*/
+bool DDR_Dma_Bench(unsigned long size, unsigned long addr)
+{
+  uint64_t start;
+  int i;
+
+  if (dma_mode != DDR_DMA_OFF)
+  {
+    printf("DMA traffic running, stop it first\n\r");
+    return false;
+  }
+
+  if (!dma_check_region(DDR_DMA_LIST_SIZE, &size, &addr) || !dma_setup())
+  {
+    return false;
+  }
+
+  if (!dma_build(DDR_DMA_COPY, size, addr, DMA_LINKEDLIST_NORMAL))
+  {
+    return false;
+  }
+
+  start = timer_get_count();
+  for (i = 0; i < DDR_DMA_BENCH_LOOP; i++)
+  {
+    if (!dma_run())
+    {
+      return false;
+    }
+  }
+  dma_print_rate(dma_mode_str[DDR_DMA_COPY], DDR_DMA_BENCH_LOOP * size / 2,
+                 DDR_DMA_BENCH_LOOP * size / 2, timer_get_count() - start);
+
+  if (!dma_build(DDR_DMA_FILL, size, addr, DMA_LINKEDLIST_NORMAL))
+  {
+    return false;
+  }
+
+  start = timer_get_count();
+  for (i = 0; i < DDR_DMA_BENCH_LOOP; i++)
+  {
+    if (!dma_run())
+    {
+      return false;
+    }
+  }
+  dma_print_rate(dma_mode_str[DDR_DMA_FILL], 0, DDR_DMA_BENCH_LOOP * size,
+                 timer_get_count() - start);
+
+  return dma_check(DDR_DMA_FILL, size, addr);
+}
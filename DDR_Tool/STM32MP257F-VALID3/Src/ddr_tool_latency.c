@@ -0,0 +1,469 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_latency.c
+  * @author  MCD Application Team
+  * @brief   DDR load latency profiler: chains of pointers are built in the
+  *          DDR (row hit, row miss, bank conflict, random or fixed stride) and
+  *          the dependent loads are timed with the PMU cycle counter.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_device_hal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ddr_addrmap.h"
+#include "ddr_tests.h"
+#include "ddr_tool_latency.h"
+#include "ddr_tool_tlm.h"
+#include "system_time.h"
+#include "stm32mp_util_ddr_conf.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  ddr_lat_chain chain;
+  unsigned long nb;
+  /* bytes, or columns for the row hit chain */
+  unsigned long stride;
+  unsigned long addr;
+  unsigned long bytes;
+  ddr_addrmap_loc start;
+  ddr_addrmap_loc size;
+} lat_desc;
+
+/* Private define ------------------------------------------------------------*/
+/* one node per cache line */
+#define DDR_LAT_LINE            64UL
+#define DDR_LAT_DFLT_SIZE       0x100000UL
+/* rows of the row miss and bank conflict chains */
+#define DDR_LAT_ROW_NB          256UL
+#define DDR_LAT_LOADS           4096
+#define DDR_LAT_CALIB_LOOP      16
+#define DDR_LAT_BIN_NB          16
+#define DDR_LAT_BAR             40
+
+#define MDCR_EL3_SPME           (1UL << 17)
+#define PMCR_EL0_E              (1UL << 0)
+#define PMCR_EL0_C              (1UL << 2)
+#define PMCR_EL0_LC             (1UL << 6)
+#define PMCNTENSET_EL0_C        (1UL << 31)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint16_t lat_sample[DDR_LAT_LOADS];
+static uint64_t lat_prng;
+
+static const char * const lat_chain_str[] = {
+  [DDR_LAT_ALL] = "all",
+  [DDR_LAT_HIT] = "hit",
+  [DDR_LAT_MISS] = "miss",
+  [DDR_LAT_CONFLICT] = "conflict",
+  [DDR_LAT_RANDOM] = "random",
+  [DDR_LAT_STRIDE] = "stride",
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/*
+ * Count the CPU cycles at EL3: the cycle counter is not stopped in secure
+ * state (PMCR_EL0.DP = 0) and MDCR_EL3.SPME allows the secure event counting.
+ */
+static void lat_pmu_enable(void)
+{
+  uint64_t mdcr;
+
+  __asm volatile("MRS %0, MDCR_EL3" : "=r" (mdcr));
+  __asm volatile("MSR MDCR_EL3, %0" : : "r" (mdcr | MDCR_EL3_SPME));
+  __asm volatile("MSR PMCCFILTR_EL0, %0" : : "r" (0UL));
+  __asm volatile("MSR PMCR_EL0, %0" : : "r" (PMCR_EL0_LC | PMCR_EL0_C |
+                                             PMCR_EL0_E));
+  __asm volatile("MSR PMCNTENSET_EL0, %0\n"
+                 "ISB\n" : : "r" (PMCNTENSET_EL0_C));
+}
+
+/* Cycles of one dependent load, barriers included */
+static uintptr_t lat_load(uintptr_t p, uint64_t *cycles)
+{
+  uint64_t t0;
+  uint64_t t1;
+
+  __asm volatile("ISB\n"
+                 "MRS %[t0], PMCCNTR_EL0\n"
+                 "LDR %[p], [%[p]]\n"
+                 "DSB LD\n"
+                 "ISB\n"
+                 "MRS %[t1], PMCCNTR_EL0\n"
+                 : [t0] "=&r" (t0), [t1] "=&r" (t1), [p] "+r" (p)
+                 : : "memory");
+  *cycles = t1 - t0;
+
+  return p;
+}
+
+/* Cycles of the barriers of lat_load(), without load */
+static uint64_t lat_calibrate(void)
+{
+  uint64_t t0;
+  uint64_t t1;
+  uint64_t min = UINT64_MAX;
+  int i;
+
+  for (i = 0; i < DDR_LAT_CALIB_LOOP; i++)
+  {
+    __asm volatile("ISB\n"
+                   "MRS %[t0], PMCCNTR_EL0\n"
+                   "DSB LD\n"
+                   "ISB\n"
+                   "MRS %[t1], PMCCNTR_EL0\n"
+                   : [t0] "=&r" (t0), [t1] "=&r" (t1) : : "memory");
+    if (t1 - t0 < min)
+    {
+      min = t1 - t0;
+    }
+  }
+
+  return min;
+}
+
+/* Dependent loads only, timed by the caller */
+static uintptr_t lat_chase(uintptr_t p, unsigned long nb)
+{
+  while (nb-- != 0U)
+  {
+    p = *(volatile uintptr_t *)p;
+  }
+
+  return p;
+}
+
+static unsigned long lat_random(unsigned long max)
+{
+  lat_prng ^= lat_prng << 13;
+  lat_prng ^= lat_prng >> 7;
+  lat_prng ^= lat_prng << 17;
+
+  return (unsigned long)(lat_prng % max);
+}
+
+/* Address of the node i of a chain */
+static uintptr_t lat_node(const lat_desc *desc, unsigned long i)
+{
+  ddr_addrmap_loc loc = desc->start;
+  unsigned long bank_nb = desc->size.bank * desc->size.bg;
+
+  switch (desc->chain)
+  {
+    case DDR_LAT_HIT:
+      /* same row, one column per cache line */
+      loc.col = i * desc->stride;
+      break;
+    case DDR_LAT_MISS:
+      /* another bank and another row at each load */
+      loc.bank = i % desc->size.bank;
+      loc.bg = (i / desc->size.bank) % desc->size.bg;
+      loc.rank = (i / bank_nb) % desc->size.rank;
+      loc.row = desc->start.row + i;
+      break;
+    case DDR_LAT_CONFLICT:
+      /* same bank, another row at each load */
+      loc.row = desc->start.row + i;
+      break;
+    default:
+      return (uintptr_t)(desc->addr + i * desc->stride);
+  }
+
+  return (uintptr_t)DDR_AddrMap_Encode(&loc);
+}
+
+/*
+ * Link the nodes in one cycle: in node order for the row miss, bank conflict
+ * and stride chains, in random order (Sattolo) for the others. The
+ * permutation is built in the nodes, then replaced by the node addresses.
+ */
+static uintptr_t lat_build(const lat_desc *desc)
+{
+  unsigned long i;
+  unsigned long j;
+  uintptr_t tmp;
+  bool shuffle = (desc->chain == DDR_LAT_HIT) ||
+                 (desc->chain == DDR_LAT_RANDOM);
+
+  /* Sattolo shuffle of the identity gives a single cycle */
+  for (i = 0; i < desc->nb; i++)
+  {
+    *(uintptr_t *)lat_node(desc, i) = shuffle ? i : (i + 1U) % desc->nb;
+  }
+
+  if (shuffle)
+  {
+    for (i = desc->nb - 1U; i > 0U; i--)
+    {
+      j = lat_random(i);
+      tmp = *(uintptr_t *)lat_node(desc, i);
+      *(uintptr_t *)lat_node(desc, i) = *(uintptr_t *)lat_node(desc, j);
+      *(uintptr_t *)lat_node(desc, j) = tmp;
+    }
+  }
+
+  for (i = 0; i < desc->nb; i++)
+  {
+    *(uintptr_t *)lat_node(desc, i) =
+      lat_node(desc, *(uintptr_t *)lat_node(desc, i));
+  }
+
+  __asm volatile("DSB SY" : : : "memory");
+
+  return lat_node(desc, 0);
+}
+
+static int lat_compare(const void *a, const void *b)
+{
+  return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+/*
+ * Print the latency of a chain, followed by a machine-readable line:
+ * LAT;<chain>;<stride>;<nodes>;<loads>;<avg ns>;<min>;<p50>;<p99>;<max cycles>;
+ *     <DDR mapping NC|WB>
+ * or only by the same values in a SAMPLE frame with "tlm on" (mapping 0 = NC,
+ * 1 = WB).
+ */
+static void lat_report(const lat_desc *desc, unsigned long avg_ns)
+{
+  unsigned long bin[DDR_LAT_BIN_NB] = {0};
+  unsigned long bin_max = 0;
+  unsigned long width;
+  unsigned int min = lat_sample[0];
+  unsigned int p50 = lat_sample[DDR_LAT_LOADS / 2];
+  unsigned int p99 = lat_sample[(DDR_LAT_LOADS * 99) / 100];
+  unsigned int max = lat_sample[DDR_LAT_LOADS - 1];
+  unsigned long i;
+  unsigned long n;
+
+  if (DDR_Tlm_Get_Enable())
+  {
+    unsigned long value[] = {
+      (desc->chain <= DDR_LAT_CONFLICT) ? 0UL : desc->stride, desc->nb,
+      DDR_LAT_LOADS, avg_ns, min, p50, p99, max, DDR_Test_Get_Cache() ? 1 : 0
+    };
+
+    DDR_Tlm_Sample("LAT", lat_chain_str[desc->chain], value,
+                   sizeof(value) / sizeof(value[0]));
+    return;
+  }
+
+  /* bins from min to p99, the slower loads are in the last one */
+  width = (p99 - min + DDR_LAT_BIN_NB) / DDR_LAT_BIN_NB;
+  for (i = 0; i < DDR_LAT_LOADS; i++)
+  {
+    n = (lat_sample[i] - min) / width;
+    if (n >= DDR_LAT_BIN_NB)
+    {
+      n = DDR_LAT_BIN_NB - 1;
+    }
+    bin[n]++;
+  }
+
+  for (i = 0; i < DDR_LAT_BIN_NB; i++)
+  {
+    if (bin[i] > bin_max)
+    {
+      bin_max = bin[i];
+    }
+  }
+
+  printf("%s: %lu nodes", lat_chain_str[desc->chain], desc->nb);
+  if (desc->chain > DDR_LAT_CONFLICT)
+  {
+    printf(" every 0x%lx bytes", desc->stride);
+  }
+  printf(", %d loads, avg %lu ns\n\r", DDR_LAT_LOADS, avg_ns);
+  printf("  cycles: min %u, p50 %u, p99 %u, max %u\n\r", min, p50, p99, max);
+
+  for (i = 0; i < DDR_LAT_BIN_NB; i++)
+  {
+    if (i < DDR_LAT_BIN_NB - 1U)
+    {
+      printf("  %5lu-%-5lu %5lu ", min + i * width,
+             min + (i + 1U) * width - 1U, bin[i]);
+    }
+    else
+    {
+      printf("  %5lu+      %5lu ", min + i * width, bin[i]);
+    }
+    for (n = 0; n < (bin[i] * DDR_LAT_BAR + bin_max - 1U) / bin_max; n++)
+    {
+      printf("#");
+    }
+    printf("\n\r");
+  }
+
+  printf("LAT;%s;%lu;%lu;%d;%lu;%u;%u;%u;%u;%s\n\r",
+         lat_chain_str[desc->chain],
+         (desc->chain <= DDR_LAT_CONFLICT) ? 0UL : desc->stride, desc->nb,
+         DDR_LAT_LOADS, avg_ns, min, p50, p99, max,
+         DDR_Test_Get_Cache() ? "WB" : "NC");
+}
+
+static bool lat_run(lat_desc *desc)
+{
+  unsigned long end = (unsigned long)DDR_MEM_BASE +
+                      (unsigned long)DDR_MEM_SIZE;
+  uint64_t overhead;
+  uint64_t cycles;
+  uint64_t ticks;
+  uintptr_t p;
+  unsigned long i;
+
+  switch (desc->chain)
+  {
+    case DDR_LAT_HIT:
+      desc->stride = DDR_LAT_LINE / DDR_AddrMap_Get_Unit();
+      desc->nb = desc->size.col / desc->stride;
+      break;
+    case DDR_LAT_MISS:
+    case DDR_LAT_CONFLICT:
+      desc->nb = desc->size.row - desc->start.row;
+      if (desc->nb > DDR_LAT_ROW_NB)
+      {
+        desc->nb = DDR_LAT_ROW_NB;
+      }
+      break;
+    default:
+      desc->nb = desc->bytes / desc->stride;
+      break;
+  }
+
+  for (i = 0; i < desc->nb; i++)
+  {
+    if (lat_node(desc, i) >= end)
+    {
+      break;
+    }
+  }
+
+  if ((desc->nb < 2U) || (i < desc->nb))
+  {
+    printf("%s: invalid chain, %lu nodes from 0x%lx\n\r",
+           lat_chain_str[desc->chain], desc->nb, desc->addr);
+    return false;
+  }
+
+  p = lat_build(desc);
+
+  /* one turn to open the rows of the chain, then the timed turns */
+  p = lat_chase(p, desc->nb);
+  ticks = timer_get_count();
+  p = lat_chase(p, DDR_LAT_LOADS);
+  ticks = timer_get_count() - ticks;
+
+  overhead = lat_calibrate();
+  for (i = 0; i < DDR_LAT_LOADS; i++)
+  {
+    p = lat_load(p, &cycles);
+    cycles = (cycles > overhead) ? cycles - overhead : 0U;
+    lat_sample[i] = (cycles > UINT16_MAX) ? UINT16_MAX : (uint16_t)cycles;
+  }
+
+  qsort(lat_sample, DDR_LAT_LOADS, sizeof(lat_sample[0]), lat_compare);
+
+  lat_report(desc, (unsigned long)((ticks * 1000000000ULL) /
+                                   timer_get_freq() / DDR_LAT_LOADS));
+
+  return true;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+* @brief Measure the latency of the DDR loads with chains of pointers.
+*   The chain contents overwrite the DDR from addr.
+* @param chain: DDR_LAT_ALL for hit, miss, conflict and random chains
+* @param stride: bytes between 2 nodes of DDR_LAT_STRIDE chain
+* @param size: bytes of the random and stride chains, 0 = default
+* @param addr: start of the chains, 0 = DDR base; the row, bank and rank of
+*   addr are used by the hit, miss and conflict chains
+* @retval false when a parameter is invalid
+*/
+bool DDR_Latency_Run(ddr_lat_chain chain, unsigned long stride,
+                     unsigned long size, unsigned long addr)
+{
+  ddr_lat_chain first = (chain == DDR_LAT_ALL) ? DDR_LAT_HIT : chain;
+  ddr_lat_chain last = (chain == DDR_LAT_ALL) ? DDR_LAT_RANDOM : chain;
+  ddr_lat_chain id;
+  lat_desc desc;
+  ddr_addrmap_loc loc;
+
+  if (size == 0U)
+  {
+    size = DDR_LAT_DFLT_SIZE;
+  }
+
+  if (addr == 0U)
+  {
+    addr = (unsigned long)DDR_MEM_BASE;
+  }
+
+  if (chain == DDR_LAT_STRIDE)
+  {
+    if ((stride < sizeof(uintptr_t)) || ((stride & 0x7U) != 0U) ||
+        (stride > size))
+    {
+      printf("stride 0x%lx invalid: multiple of 8\n\r", stride);
+      return false;
+    }
+  }
+  else
+  {
+    stride = DDR_LAT_LINE;
+  }
+
+  DDR_AddrMap_Update();
+  if (((addr & 0x7U) != 0U) || (size > (unsigned long)DDR_MEM_SIZE) ||
+      !DDR_AddrMap_Decode(addr, &desc.start) ||
+      !DDR_AddrMap_Decode(addr + size - 1U, &loc))
+  {
+    printf("address 0x%lx or size 0x%lx invalid\n\r", addr, size);
+    return false;
+  }
+  DDR_AddrMap_Get_Size(&desc.size);
+
+  if (DDR_Test_Get_Cache())
+  {
+    printf("Warning: DDR mapped write-back, the loads can hit the caches\n\r");
+  }
+
+  lat_prng = DDR_Test_Get_Seed();
+  if (lat_prng == 0U)
+  {
+    lat_prng = timer_get_count() | 1U;
+  }
+
+  lat_pmu_enable();
+
+  for (id = first; id <= last; id++)
+  {
+    desc.chain = id;
+    desc.addr = addr;
+    desc.bytes = size;
+    desc.stride = stride;
+    if (!lat_run(&desc))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,402 @@
+/**
+  ******************************************************************************
+  * @file    ddr_tool_smp.c
+  * @author  MCD Application Team
+  * @brief   Execution of the DDR tests on both Cortex-A35 cores: the A35_1
+  *          core waits for requests posted by the A35_0 core in a mailbox,
+  *          the address range of a test is split between the two cores.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_device_hal.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include "ddr_tests.h"
+#include "ddr_tool_smp.h"
+#include "ddr_tool_util.h"
+#include "system_time.h"
+#include "stm32mp_util_ddr_conf.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+  DDR_SMP_IDLE = 0,
+  DDR_SMP_REQUEST,
+  DDR_SMP_DONE,
+} ddr_smp_state;
+
+/* Request of the A35_0 core to the A35_1 core */
+typedef struct {
+  uint32_t (*fct)();
+  unsigned long arg[3];
+  uint8_t nb_args;
+  uint32_t ret;
+  volatile uint32_t state;
+} ddr_smp_mailbox;
+
+/* Private define ------------------------------------------------------------*/
+#define DDR_SMP_STACK_SIZE      0x2000
+/* default size of the tests, used when the size argument is 0 */
+#define DDR_SMP_DFLT_SIZE       (4 * 1024)
+/* each half must respect the size alignment of all the tests */
+#define DDR_SMP_ALIGN           128
+#define DDR_SMP_START_TIMEOUT   100000 /* us */
+/* A35_1 part ended at most this delay after twice the A35_0 part duration */
+#define DDR_SMP_DONE_TIMEOUT    1000000 /* us */
+
+/* Private macro -------------------------------------------------------------*/
+#define smp_dmb()   __asm volatile("DMB SY" : : : "memory")
+#define smp_dsb()   __asm volatile("DSB SY" : : : "memory")
+#define smp_sev()   __asm volatile("SEV" : : : "memory")
+#define smp_wfe()   __asm volatile("WFE" : : : "memory")
+
+/* Private variables ---------------------------------------------------------*/
+/*
+ * The A35_1 core waits in the startup code until ddr_smp_core1_entry is set:
+ * both variables are placed in .data as they are read before the bss
+ * initialization done by the A35_0 core.
+ */
+volatile uintptr_t ddr_smp_core1_entry __attribute__((section(".data"))) = 0;
+volatile uintptr_t ddr_smp_core1_sp __attribute__((section(".data"))) = 0;
+
+static uint64_t core1_stack[DDR_SMP_STACK_SIZE / sizeof(uint64_t)]
+  __attribute__((aligned(16)));
+
+static ddr_smp_mailbox mailbox;
+static volatile uint32_t core1_ready;
+static bool smp_enable;
+
+/*
+ * Peterson lock serializing the output of both cores: the memory is mapped
+ * non-cacheable, so no exclusive access is used.
+ */
+static volatile uint32_t lock_flag[2];
+static volatile uint32_t lock_turn;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+static unsigned int get_core_id(void)
+{
+  uint64_t mpidr;
+
+  __asm volatile("MRS %0, MPIDR_EL1" : "=r" (mpidr));
+
+  return (unsigned int)(mpidr & 0x1U);
+}
+
+static void smp_lock(void)
+{
+  unsigned int id = get_core_id();
+  unsigned int other = 1U - id;
+
+  lock_flag[id] = 1;
+  lock_turn = other;
+  smp_dmb();
+
+  /* the A35_1 core may wait for the A35_0 core to send its output */
+  while ((lock_flag[other] != 0U) && (lock_turn == other))
+  {
+    UART_Tx_Poll();
+  }
+
+  smp_dmb();
+}
+
+static void smp_unlock(void)
+{
+  smp_dmb();
+  lock_flag[get_core_id()] = 0;
+}
+
+static uint32_t smp_call(uint32_t (*fct)(), uint8_t nb_args,
+                         const unsigned long *arg)
+{
+  switch (nb_args)
+  {
+    case 0:
+      return fct();
+    case 1:
+      return fct(arg[0]);
+    case 2:
+      return fct(arg[0], arg[1]);
+    case 3:
+      return fct(arg[0], arg[1], arg[2]);
+    default:
+      return 0xFFFFFFFF;
+  }
+}
+
+/* Main loop of the A35_1 core, executed on its own stack */
+static void core1_main(void)
+{
+  core1_ready = 1;
+  smp_dsb();
+  smp_sev();
+
+  while (1)
+  {
+    while (mailbox.state != DDR_SMP_REQUEST)
+    {
+      smp_wfe();
+    }
+
+    mailbox.ret = smp_call(mailbox.fct, mailbox.nb_args, mailbox.arg);
+    /* no dirty line left in the caches of A35_1 (not coherent) */
+    DDR_Test_Cache_Flush();
+
+    smp_dmb();
+    mailbox.state = DDR_SMP_DONE;
+    smp_dsb();
+    smp_sev();
+  }
+}
+
+/*
+ * Wait for the end of the A35_1 request, posted at 'start' (generic timer
+ * count), while sending its output. On timeout, A35_1 is considered lost
+ * (e.g. abort in its part of the test): the SMP mode is disabled.
+ */
+static bool smp_wait_done(uint64_t start)
+{
+  uint64_t timeout;
+
+  timeout = timer_get_count() + (timer_get_count() - start) +
+            ((uint64_t)timer_get_freq() * DDR_SMP_DONE_TIMEOUT) / 1000000U;
+  while (mailbox.state != DDR_SMP_DONE)
+  {
+    UART_Tx_Poll();
+    if (timer_get_count() > timeout)
+    {
+      printf("A35_1 core not answering, smp disabled\n\r");
+      mailbox.state = DDR_SMP_IDLE;
+      core1_ready = 0;
+      smp_enable = false;
+      return false;
+    }
+  }
+  smp_dmb();
+  mailbox.state = DDR_SMP_IDLE;
+
+  return true;
+}
+
+static bool smp_start(void)
+{
+  uint64_t timeout;
+
+  if (core1_ready != 0U)
+  {
+    return true;
+  }
+
+  ddr_smp_core1_sp = (uintptr_t)&core1_stack[DDR_SMP_STACK_SIZE /
+                                             sizeof(uint64_t)];
+  smp_dmb();
+  ddr_smp_core1_entry = (uintptr_t)core1_main;
+  smp_dsb();
+  smp_sev();
+
+  timeout = timer_get_count() +
+            ((uint64_t)timer_get_freq() * DDR_SMP_START_TIMEOUT) / 1000000U;
+  while (core1_ready == 0U)
+  {
+    if (timer_get_count() > timeout)
+    {
+      printf("A35_1 core not started\n\r");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+* @brief Select the execution of the tests on one or both cores.
+*   The A35_1 core is started at the first activation.
+* @param enable: true = the range-based tests are split on both cores
+* @retval true when the selection is applied
+*/
+bool DDR_Smp_Set_Enable(bool enable)
+{
+  if (enable && !smp_start())
+  {
+    return false;
+  }
+
+  smp_enable = enable;
+
+  return true;
+}
+
+/**
+* @brief Get the execution mode of the tests.
+* @retval true when the tests run on both cores
+*/
+bool DDR_Smp_Get_Enable(void)
+{
+  return smp_enable;
+}
+
+/**
+* @brief Execute a range-based test on both cores: the A35_0 core tests the
+*   1st half of the range, the A35_1 core the 2nd half at the same time.
+*   The test is executed on A35_0 only when the range can't be split.
+* @param fct: test function, with [size] as 1st and [addr] as last argument
+* @param nb_args: number of arguments of the test (2 or 3)
+* @param arg: arguments of the test
+* @retval result of the A35_0 part when it fails, else of the A35_1 part,
+*   0xFFFFFFFF when the A35_1 core doesn't answer (SMP mode then disabled)
+*/
+uint32_t DDR_Smp_Run(uint32_t (*fct)(), uint8_t nb_args,
+                     const unsigned long *arg)
+{
+  unsigned long arg0[3];
+  unsigned long size;
+  unsigned long addr;
+  unsigned long half;
+  uint64_t start;
+  uint32_t ret;
+  uint8_t i;
+
+  size = (arg[0] != 0U) ? arg[0] : DDR_SMP_DFLT_SIZE;
+  addr = (arg[nb_args - 1] != 0U) ? arg[nb_args - 1] :
+                                    (unsigned long)DDR_MEM_BASE;
+
+  /* invalid sizes are reported by the test itself */
+  if (!smp_enable || (nb_args < 2) || (nb_args > 3) ||
+      (size > (unsigned long)DDR_MEM_SIZE) ||
+      ((size & ((2 * DDR_SMP_ALIGN) - 1)) != 0U))
+  {
+    return smp_call(fct, nb_args, arg);
+  }
+
+  half = size / 2;
+
+  for (i = 0; i < nb_args; i++)
+  {
+    arg0[i] = arg[i];
+    mailbox.arg[i] = arg[i];
+  }
+
+  arg0[0] = half;
+  arg0[nb_args - 1] = addr;
+  mailbox.arg[0] = size - half;
+  mailbox.arg[nb_args - 1] = addr + half;
+  mailbox.fct = fct;
+  mailbox.nb_args = nb_args;
+
+  start = timer_get_count();
+  smp_dmb();
+  mailbox.state = DDR_SMP_REQUEST;
+  smp_dsb();
+  smp_sev();
+
+  ret = smp_call(fct, nb_args, arg0);
+
+  /* the output of the A35_1 core is sent by the A35_0 core */
+  if (!smp_wait_done(start))
+  {
+    return 0xFFFFFFFF;
+  }
+
+  if (ret != 0U)
+  {
+    return ret;
+  }
+
+  return mailbox.ret;
+}
+
+/**
+* @brief Execute a function on the A35_1 core only, e.g. a local TLB
+*   maintenance: the cores don't receive the broadcast maintenance operations
+*   (CPUECTLR_EL1.SMPEN cleared by the startup code). The caches of A35_1 are
+*   flushed after the function.
+* @param fct: function without argument
+* @retval result of fct, 0 when the A35_1 core is not started, 0xFFFFFFFF
+*   when it doesn't answer
+*/
+uint32_t DDR_Smp_Run_Core1(uint32_t (*fct)(void))
+{
+  if (core1_ready == 0U)
+  {
+    return 0;
+  }
+
+  mailbox.fct = fct;
+  mailbox.nb_args = 0;
+
+  smp_dmb();
+  mailbox.state = DDR_SMP_REQUEST;
+  smp_dsb();
+  smp_sev();
+
+  if (!smp_wait_done(timer_get_count()))
+  {
+    return 0xFFFFFFFF;
+  }
+
+  return mailbox.ret;
+}
+
+/**
+* @brief printf serialized between both cores, used by the tests.
+* @param format: printf format
+* @retval Number of characters printed
+*/
+int DDR_Smp_Printf(const char *format, ...)
+{
+  va_list args;
+  int ret;
+
+  va_start(args, format);
+  ret = DDR_Smp_Vprintf(format, args);
+  va_end(args);
+
+  return ret;
+}
+
+/**
+* @brief vprintf serialized between both cores.
+* @param format: printf format
+* @param args: arguments of the format
+* @retval Number of characters printed
+*/
+int DDR_Smp_Vprintf(const char *format, va_list args)
+{
+  int ret;
+
+  smp_lock();
+  ret = vprintf(format, args);
+  smp_unlock();
+
+  return ret;
+}
+
+/**
+* @brief Binary write on the console serialized between both cores, used by
+*   the telemetry frames.
+* @param buf: bytes to write
+* @param len: number of bytes
+* @retval None
+*/
+void DDR_Smp_Write(const void *buf, size_t len)
+{
+  smp_lock();
+  (void)fwrite(buf, 1, len, stdout);
+  (void)fflush(stdout);
+  smp_unlock();
+}
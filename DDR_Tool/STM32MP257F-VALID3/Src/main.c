@@ -18,6 +18,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "ddr_tool_trace.h"
 #include "stm32mp_util_conf.h"
 
 /** @addtogroup STM32MP2xx_HAL_Examples
@@ -71,14 +72,15 @@ int main(void)
 
   HAL_Init();
 
-  /* Dummy delay to ensure SysTick is running fine
+  /* Configure A35 system clock, because some parts are only reachable in EL3 */
+  /* It starts STGEN, the time base of the delays */
+  Mon_A35SystemClockConfig();
+
+  /* Dummy delay to ensure the generic timer is running fine
    * If it is not we will be stuck here
    */
   valid_delay_us(10 * 1000);
 
-  /* Configure A35 system clock, because some parts are only reachable in EL3 */
-  Mon_A35SystemClockConfig();
-
   /* Configure the system clock */
   SystemClock_Config();
 
@@ -88,6 +90,9 @@ int main(void)
   /*  Configure USART for logging messages  */
   UART_Config();
 
+  /* Start the event trace, before the DDR initialization */
+  DDR_Trace_Init();
+
   /*****************************/
   /* Test environment settings */
   /*****************************/
@@ -105,13 +110,27 @@ int main(void)
   iddr.self_refresh = false;
   iddr.zdata = 0;
   iddr.clear_bkp = false;
+#ifdef UTIL_DDR_RESTORE_TRAINING
+  iddr.restore_training = true;
+#else
+  iddr.restore_training = false;
+#endif
 
   if (HAL_DDR_Init(&iddr) != HAL_OK)
   {
     printf("DDR Initialization KO\n\r");
+    UART_Tx_Flush();
     return 1;
   }
 
+  if (iddr.training_restored)
+  {
+    printf("DDR training skipped, saved results restored\n\r");
+  }
+
+  /* Send the console output before the infinite loop */
+  UART_Tx_Flush();
+
   /* Infinite loop */
   while (1)
   {
@@ -153,7 +172,7 @@ void Mon_A35SystemClockConfig( void )
    /* Set CNTFRQ_EL0 register according to STGEN frequency in Hz */
    /* see ARM DDI0487B.a page 2673 #D7.5.1 "CNTFRQ_EL0" */
    reg32_val = READ_REG(STGENC->CNTFID0);
-   asm volatile("MSR CNTFRQ_EL0, %0" : "=r" (reg32_val));
+   asm volatile("MSR CNTFRQ_EL0, %0" : : "r" ((uint64_t)reg32_val));
 
    return;
 }
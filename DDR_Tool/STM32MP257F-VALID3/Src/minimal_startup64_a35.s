@@ -603,9 +603,20 @@ after_neon:
         b       exit
 
 servant_core1:
-        /* A35_1 core : Branch to its own main function */
-//        b       main_a35_1
-        b      servant_core1
+        /* A35_1 core : wait until the A35_0 core provides an entry point */
+        /* and a stack (see ddr_tool_smp.c), then branch to this entry    */
+        ldr     x1, =ddr_smp_core1_entry
+        ldr     x2, =ddr_smp_core1_sp
+wait_core1_entry:
+        ldr     x0, [x1]
+        cbnz    x0, start_core1
+        wfe
+        b       wait_core1_entry
+start_core1:
+        ldr     x2, [x2]
+        mov     sp, x2
+        blr     x0
+        b       servant_core1
 
 /*============================================================================*/
 /* Pagetables Initialization                                                  */
@@ -265,20 +265,6 @@ uint32_t BSP_PMIC_DumpRegs (void)
 }
 #endif
 
-#ifdef __AARCH64__
-static void bsp_pmic_delay_us(unsigned long delay_us)
-{
-  __IO uint32_t wait_loop_index = 0U;
-
-  wait_loop_index = (delay_us * (SystemCoreClock / (1000000UL * 2UL)));
-
-  while(wait_loop_index != 0UL)
-  {
-    wait_loop_index--;
-  }
-}
-#endif
-
 /*
  *
  * @brief BSP_PMIC_DDR_Power_Init initialize DDR power
@@ -313,11 +299,7 @@ uint32_t BSP_PMIC_DDR_Power_Init()
   if (BSP_PMIC_UpdateReg(board_regulators_table[VPP_DDR].control_reg1, 0x1) != BSP_ERROR_NONE)
 	  return BSP_ERROR_PMIC;
 
-#ifdef __AARCH64__
-  bsp_pmic_delay_us(2);
-#else
-  HAL_Delay(2);
-#endif
+  HAL_DelayUs(2000);
 
   /* enable vdd_ddr */
   if (BSP_PMIC_UpdateReg(board_regulators_table[VDD_DDR].control_reg2, 0x1 != BSP_ERROR_NONE))
@@ -440,7 +422,7 @@ uint32_t BSP_PMIC_DDR_Power_Off()
   if (BSP_PMIC_WriteReg(board_regulators_table[VPP_DDR].control_reg1, data) != BSP_ERROR_NONE) /* write control reg to clear enable bit */
 	  return BSP_ERROR_PMIC;
 
-  HAL_Delay(2);
+  HAL_DelayUs(2000);
 
   /* disable vdd_ddr */
   if (BSP_PMIC_ReadReg(board_regulators_table[VDD_DDR].control_reg2, &data) != BSP_ERROR_NONE) /* read control reg to save data */
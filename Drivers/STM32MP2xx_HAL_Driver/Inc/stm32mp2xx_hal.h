@@ -1377,6 +1377,11 @@ HAL_StatusTypeDef     HAL_InitTick (uint32_t TickPriority);
 void                  HAL_IncTick(void);
 void                  HAL_Delay(__IO uint32_t Delay);
 uint32_t              HAL_GetTick(void);
+uint64_t              HAL_GetTimerCount(void);
+uint32_t              HAL_GetTimerFreq(void);
+uint64_t              HAL_TimeoutInitUs(uint32_t Timeout);
+uint32_t              HAL_IsTimeoutElapsed(uint64_t Timeout);
+void                  HAL_DelayUs(uint32_t Delay);
 void                  HAL_SuspendTick(void);
 void                  HAL_ResumeTick(void);
 uint32_t              HAL_GetHalVersion(void);
@@ -328,8 +328,73 @@ typedef enum  {
 	STEP_DDR_READY,
 	STEP_RUN,
 }HAL_DDR_InteractStepTypeDef;
+
+/**
+  * @brief  HAL DDR register dump output, called for each register instead of
+  *         printf: base ("ctl", "uib", ..., "pll"), section and register name
+  */
+typedef void (*HAL_DDR_RegOutputTypeDef)(const char *base, const char *section,
+                                         const char *name, uint32_t value);
 #endif /* DDR_INTERACTIVE */
 
+/**
+  * @brief  HAL DDR trace event definition, see HAL_DDR_Trace()
+  */
+typedef enum {
+  HAL_DDR_TRACE_INIT = 1,   /*!< HAL_DDR_Init() start, arg: wakeup_from_standby */
+  HAL_DDR_TRACE_RESET,      /*!< DDR reset start, arg: wakeup_from_standby */
+  HAL_DDR_TRACE_CTL_INIT,   /*!< DDRCTRL registers set */
+  HAL_DDR_TRACE_PHY_STAGE,  /*!< PhyInit step start, arg: HAL_DDR_TRACE_PHY_ARG() */
+  HAL_DDR_TRACE_PHY_INIT,   /*!< PhyInit sequence end, arg: return code */
+  HAL_DDR_TRACE_READY,      /*!< DDRCTRL active, AXI ports enabled */
+  HAL_DDR_TRACE_INIT_END,   /*!< HAL_DDR_Init() end, arg: HAL status */
+  HAL_DDR_TRACE_SYSCONF,    /*!< System configuration start */
+  HAL_DDR_TRACE_SET_REG,    /*!< Register group write start, arg: group index
+                                 (static, timing, perf, map, basic, advanced,
+                                 mode_register, swizzle) */
+  HAL_DDR_TRACE_REFRESH,    /*!< Refresh restore or self-refresh exit start */
+  HAL_DDR_TRACE_RESTORE,    /*!< PHY registers restore start, arg:
+                                 wakeup_from_standby */
+} HAL_DDR_TraceEventTypeDef;
+
+/**
+  * @brief  Sizes of HAL_DDR_TrainingResultTypeDef
+  */
+#define HAL_DDR_TRAINING_CHANNEL_MAX  2U
+#define HAL_DDR_TRAINING_RANK_MAX     4U
+#define HAL_DDR_TRAINING_NIBBLE_MAX   20U
+
+/**
+  * @brief  Critical delay difference types of HAL_DDR_TrainingResultTypeDef:
+  *         read to read, write to write, read to write, write to read
+  */
+#define HAL_DDR_CDD_RR  0U
+#define HAL_DDR_CDD_WW  1U
+#define HAL_DDR_CDD_RW  2U
+#define HAL_DDR_CDD_WR  3U
+#define HAL_DDR_CDD_NB  4U
+
+/**
+  * @brief  HAL DDR training results of a P-state, read from the output fields
+  *         of the training firmware message block, see
+  *         HAL_DDR_GetTrainingResult()
+  */
+typedef struct {
+  uint16_t revision;        /*!< training firmware revision (pmurevision) */
+  uint8_t cs_test_fail;     /*!< non-zero when the training failed on a rank
+                                 (cstestfail) */
+  uint8_t channel_nb;       /*!< 2 for the LPDDR4 channels A and B, else 1 */
+  uint8_t rank_nb;          /*!< number of trained ranks of each channel */
+  uint8_t vref_nb;          /*!< number of trained VrefDQ nibbles of each rank,
+                                 DDR4 only */
+  /*!< critical delay differences (cdd_*) [channel][HAL_DDR_CDD_xx][from rank]
+       [to rank], signed, 0 for the same rank in RR and WW */
+  int8_t cdd[HAL_DDR_TRAINING_CHANNEL_MAX][HAL_DDR_CDD_NB]
+            [HAL_DDR_TRAINING_RANK_MAX][HAL_DDR_TRAINING_RANK_MAX];
+  /*!< trained VrefDQ [rank][nibble] (vrefdqr*nib*), mr6[6:0] value */
+  uint8_t vref[HAL_DDR_TRAINING_RANK_MAX][HAL_DDR_TRAINING_NIBBLE_MAX];
+} HAL_DDR_TrainingResultTypeDef;
+
 /**
   * @brief  DDR Initialization Structure definition
   */
@@ -358,6 +423,21 @@ typedef struct
                                  Specifies if backup should be cleared after
                                  DDR initialization (DDR lost content case).
                                  Clear requested if true. */
+
+  bool restore_training;    /*!< [input]
+                                 Specifies if the training can be skipped
+                                 when not waking up from standby: the PHY
+                                 registers saved in the retention area after
+                                 a previous training are restored when their
+                                 version, PHY settings and CRC are valid, and
+                                 the DRAM devices are initialized by DDRCTRL.
+                                 A full training is done when they are not,
+                                 or when the DDR tests fail after the
+                                 restore. */
+
+  bool training_restored;   /*!< [output]
+                                 Specifies if the DDR is initialized with
+                                 the restored training results. */
 } DDR_InitTypeDef;
 
 /**
@@ -369,6 +449,13 @@ typedef struct
   * @{
   */
 
+/**
+  * @brief  Maximum number of arguments of a training firmware streaming
+  *         message given to HAL_DDR_TraceTraining(), the next ones are read
+  *         from the mailbox and dropped
+  */
+#define HAL_DDR_TRAINING_ARG_MAX  16U
+
 /**
   * @}
   */
@@ -378,6 +465,15 @@ typedef struct
   * @{
   */
 
+/**
+  * @brief  Argument of HAL_DDR_TRACE_PHY_STAGE: PhyInit step letter of the App
+  *         Note ('C', 'D', ...) and P-state, or 'M' for the message block
+  *         computation, 'S' for the training skip and 'R' for the retention
+  *         registers save
+  */
+#define HAL_DDR_TRACE_PHY_ARG(step, pstate) \
+  ((uint32_t)(step) | ((uint32_t)(pstate) << 8))
+
 /**
   * @}
   */
@@ -394,6 +490,11 @@ HAL_StatusTypeDef HAL_DDR_SR_Exit(void);
 HAL_StatusTypeDef HAL_DDR_SR_SetMode(HAL_DDR_SelfRefreshModeTypeDef mode);
 HAL_DDR_SelfRefreshModeTypeDef HAL_DDR_SR_ReadMode(void);
 HAL_StatusTypeDef HAL_DDR_SetRetentionAreaBase(unsigned long base);
+void HAL_DDR_Trace(HAL_DDR_TraceEventTypeDef event, uint32_t arg);
+void HAL_DDR_TraceTraining(bool major, uint32_t msg, const uint32_t *arg,
+                           uint32_t nb);
+HAL_StatusTypeDef HAL_DDR_GetTrainingResult(uint32_t pstate,
+                                            HAL_DDR_TrainingResultTypeDef *result);
 
 #ifdef DDR_INTERACTIVE
 void HAL_DDR_Convert_Case(const char *in_str, char *out_str, bool ToUpper);
@@ -401,6 +502,7 @@ bool HAL_DDR_Interactive(HAL_DDR_InteractStepTypeDef step);
 HAL_StatusTypeDef HAL_DDR_Dump_Param(HAL_DDR_ConfigTypeDef *config,
                                      const char *name);
 HAL_StatusTypeDef HAL_DDR_Dump_Reg(const char *name, bool save);
+void HAL_DDR_Set_Reg_Output(HAL_DDR_RegOutputTypeDef output);
 void HAL_DDR_Edit_Param(HAL_DDR_ConfigTypeDef *config, char *name,
                         char *string);
 void HAL_DDR_Edit_Reg(char *name, char *string);
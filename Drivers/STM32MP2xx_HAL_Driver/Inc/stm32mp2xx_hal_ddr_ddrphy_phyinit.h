@@ -21,6 +21,8 @@ extern struct user_input_swizzle userinputswizzle;
 
 extern struct pmu_smb_ddr_1d mb_ddr_1d[NB_PS];
 extern struct pmu_smb_ddr_1d shdw_ddr_1d[NB_PS];
+extern struct pmu_smb_ddr_1d res_ddr_1d[NB_PS];
+extern bool res_ddr_1d_read[NB_PS];
 
 /* Function definitions */
 int ddrphy_phyinit_softsetmb(int ps, char *field, int value);
@@ -195,7 +195,7 @@ void ddrphy_phyinit_d_loadimem(void);
 void ddrphy_phyinit_progcsrskiptrain(bool skip_training);
 int ddrphy_phyinit_f_loaddmem(int pstate);
 int ddrphy_phyinit_g_execfw(void);
-void ddrphy_phyinit_h_readmsgblock(void);
+void ddrphy_phyinit_h_readmsgblock(int pstate);
 void ddrphy_phyinit_i_loadpieimage(bool skip_training);
 void ddrphy_phyinit_loadpieprodcode(void);
 int ddrphy_phyinit_mapdrvstren(int drvstren_ohm, enum drvtype targetcsr);
@@ -207,6 +207,7 @@ void ddrphy_phyinit_writeoutmem(uint32_t *mem, int mem_offset, int mem_size);
 void ddrphy_phyinit_writeoutmsgblk(uint16_t *mem, int mem_offset, int mem_size);
 int ddrphy_phyinit_isdbytedisabled(int dbytenumber);
 int ddrphy_phyinit_setretreglistbase(unsigned long base);
+int ddrphy_phyinit_checkretregs(void);
 int ddrphy_phyinit_trackreg(uint32_t adr);
 int ddrphy_phyinit_reginterface(enum reginstr myreginstr, uint32_t adr, uint16_t dat);
 
@@ -216,7 +217,7 @@ extern void ddrphy_phyinit_usercustom_custompretrain(void);
 extern void ddrphy_phyinit_usercustom_customposttrain(void);
 extern int ddrphy_phyinit_usercustom_e_setdficlk(int dfi_frequency);
 extern int ddrphy_phyinit_usercustom_g_waitfwdone(void);
-extern void ddrphy_phyinit_usercustom_h_readmsgblock(void);
+extern void ddrphy_phyinit_usercustom_h_readmsgblock(int pstate);
 extern void ddrphy_phyinit_usercustom_j_entermissionmode(void);
 extern int ddrphy_phyinit_usercustom_saveretregs(void);
 
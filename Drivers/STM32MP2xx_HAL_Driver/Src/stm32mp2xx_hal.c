@@ -374,6 +374,97 @@ __weak void HAL_Delay(__IO uint32_t Delay)
   }
 }
 
+/**
+  * @brief Provides the counter used by the microsecond delays and timeouts.
+  * @note On Cortex-A35, it is the generic timer physical count (CNTPCT),
+  *       clocked by STGEN: it does not depend on the CPU clock or caches and
+  *       needs no interrupt. Other cores use the tick (HAL_GetTick()).
+  * @retval counter value, incremented at HAL_GetTimerFreq() Hz
+  */
+uint64_t HAL_GetTimerCount(void)
+{
+#if defined (CORE_CA35)
+#ifdef __AARCH64__
+  uint64_t count;
+
+  /* ISB: do not read the counter ahead of the preceding instructions */
+  __asm volatile("ISB\n\t"
+                 "MRS %0, CNTPCT_EL0" : "=r" (count) : : "memory");
+
+  return count;
+#else
+  __ISB();
+
+  return __get_CNTPCT();
+#endif /* __AARCH64__ */
+#else /* M33 or M0PLUS */
+  return HAL_GetTick();
+#endif
+}
+
+/**
+  * @brief Provides the frequency of HAL_GetTimerCount().
+  * @retval frequency in Hz, 0 when CNTFRQ is not programmed
+  */
+uint32_t HAL_GetTimerFreq(void)
+{
+#if defined (CORE_CA35)
+#ifdef __AARCH64__
+  uint64_t freq;
+
+  __asm volatile("MRS %0, CNTFRQ_EL0" : "=r" (freq));
+
+  return (uint32_t)freq;
+#else
+  return __get_CNTFRQ();
+#endif /* __AARCH64__ */
+#else /* M33 or M0PLUS */
+  return 1000U;
+#endif
+}
+
+/**
+  * @brief Provides the end count of a timeout, for HAL_IsTimeoutElapsed().
+  * @note The count is rounded up: the timeout lasts at least Timeout us.
+  * @note STGEN must be started: a stopped counter never reaches the end count.
+  * @param Timeout: timeout in microseconds
+  * @retval HAL_GetTimerCount() value at the end of the timeout
+  */
+uint64_t HAL_TimeoutInitUs(uint32_t Timeout)
+{
+  uint64_t freq = HAL_GetTimerFreq();
+
+  return HAL_GetTimerCount() + (((uint64_t)Timeout * freq) + 999999U) / 1000000U;
+}
+
+/**
+  * @brief Checks the end of a timeout.
+  * @param Timeout: value returned by HAL_TimeoutInitUs()
+  * @retval 1 when the timeout is elapsed, 0 else
+  */
+uint32_t HAL_IsTimeoutElapsed(uint64_t Timeout)
+{
+  return (HAL_GetTimerCount() > Timeout) ? 1U : 0U;
+}
+
+/**
+  * @brief This function provides a delay (in microseconds) based on
+  *        HAL_GetTimerCount(), accurate to the timer period.
+  * @note STGEN must be started before the first call, as for
+  *       HAL_IsTimeoutElapsed(): with a stopped counter the delay never ends.
+  *       The delay is only skipped when CNTFRQ is 0.
+  * @param Delay: specifies the delay time length, in microseconds.
+  * @retval None
+  */
+void HAL_DelayUs(uint32_t Delay)
+{
+  uint64_t timeout = HAL_TimeoutInitUs(Delay);
+
+  while (HAL_GetTimerCount() < timeout)
+  {
+  }
+}
+
 /**
   * @brief Suspend Tick increment.
   * @note In the default implementation , SysTick timer is the source of time base. It is
@@ -32,6 +32,7 @@
 #include <ctype.h>
 #endif /* DDR_INTERACTIVE */
 #include <stdbool.h>
+#include <stdint.h>
 #ifdef DDR_INTERACTIVE
 #include <stdlib.h>
 #endif /* DDR_INTERACTIVE */
@@ -180,6 +181,14 @@ typedef struct {
   base_type base;
 }ddr_reg_info;
 
+#ifdef DDR_INTERACTIVE
+/* Entry of the register name index: descriptor index of ddr_registers[type] */
+typedef struct {
+  uint8_t type;
+  uint8_t index;
+}reg_name_entry;
+#endif /* DDR_INTERACTIVE */
+
 typedef enum {
   REG_REG,
   REG_TIMING,
@@ -1093,6 +1102,24 @@ __weak int HAL_DDR_MspInit(__attribute__((unused))ddr_type type)
   return 0;
 }
 
+/* application-specific record of the DDR initialization steps. */
+__weak void HAL_DDR_Trace(__attribute__((unused))HAL_DDR_TraceEventTypeDef event,
+                          __attribute__((unused))uint32_t arg)
+{
+}
+
+/*
+ * application-specific record of the training firmware messages: major
+ * message, or streaming message (string index and argument number) with its
+ * first HAL_DDR_TRAINING_ARG_MAX arguments.
+ */
+__weak void HAL_DDR_TraceTraining(__attribute__((unused))bool major,
+                                  __attribute__((unused))uint32_t msg,
+                                  __attribute__((unused))const uint32_t *arg,
+                                  __attribute__((unused))uint32_t nb)
+{
+}
+
 /*******************************************************************************
  * This function tests a simple read/write access to the DDR.
  * Note that the previous content is restored after test.
@@ -1232,45 +1259,6 @@ static unsigned long ddr_check_size(void)
   return offset;
 }
 
-static void ddr_delay_us(unsigned long delay_us)
-{
-  __IO uint32_t wait_loop_index = 0U;
-
-  wait_loop_index = (delay_us * (SystemCoreClock / (1000000UL * 2UL)));
-
-  #ifdef USE_STM32MP257CXX_EMU
-  wait_loop_index *= 10;
-  #endif
-
-  while(wait_loop_index != 0UL)
-  {
-    wait_loop_index--;
-  }
-}
-
-static __IO uint32_t ddr_timeout_init_us(unsigned long timeout_us)
-{
-  __IO uint32_t wait_loop_index = 0U;
-
-  wait_loop_index = timeout_us * (SystemCoreClock / (1000000UL * 2UL));
-
-  #ifdef USE_STM32MP257CXX_EMU
-  wait_loop_index *= 10;
-  #endif
-
-  return wait_loop_index;
-}
-
-static bool ddr_timeout_elapsed(__IO uint32_t timeout)
-{
-  if (timeout == 0U)
-  {
-    return true;
-  }
-
-  return false;
-}
-
 /* Start quasi dynamic register update */
 static void start_sw_done(void)
 {
@@ -1281,7 +1269,7 @@ static void start_sw_done(void)
 static int wait_sw_done_ack(void)
 {
   uint32_t swstat;
-  __IO uint32_t timeout = ddr_timeout_init_us(DDR_TIMEOUT_1_US);
+  uint64_t timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_US_1S);
 
   SET_BIT(DDRC->SWCTL, DDRC_SWCTL_SW_DONE);
 
@@ -1289,8 +1277,7 @@ static int wait_sw_done_ack(void)
   {
     swstat = READ_REG(DDRC->SWSTAT);
 
-    timeout--;
-    if (ddr_timeout_elapsed(timeout))
+    if (HAL_IsTimeoutElapsed(timeout) != 0U)
     {
       return -1; /* Timeout initialising DRAM */
     }
@@ -1313,7 +1300,7 @@ static void enable_axi_port(void)
 
 static int disable_axi_port(void)
 {
-  __IO uint32_t timeout;
+  uint64_t timeout;
 
   /* Disable uMCTL2 AXI port 0 */
   CLEAR_BIT(DDRC->PCTRL_0, DDRC_PCTRL_0_PORT_EN);
@@ -1325,11 +1312,10 @@ static int disable_axi_port(void)
    * Poll PSTAT.rd_port_busy_n = 0
    * Poll PSTAT.wr_port_busy_n = 0
    */
-  timeout = ddr_timeout_init_us(DDR_TIMEOUT_US_1S);
+  timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_US_1S);
   while (READ_REG(DDRC->PSTAT))
   {
-    timeout--;
-    if (ddr_timeout_elapsed(timeout))
+    if (HAL_IsTimeoutElapsed(timeout) != 0U)
     {
       return -1;
     }
@@ -1350,7 +1336,7 @@ static void enable_host_interface(void)
 
 static int disable_host_interface(void)
 {
-  __IO uint32_t timeout;
+  uint64_t timeout;
   uint32_t dbgcam;
   int count = 0;
 
@@ -1366,11 +1352,10 @@ static int disable_host_interface(void)
    * data_pipeline fields must be polled twice to ensure
    * value propoagation, so count is added to loop condition.
    */
-  timeout = ddr_timeout_init_us(DDR_TIMEOUT_US_1S);
+  timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_US_1S);
   do {
     dbgcam = READ_REG(DDRC->DBGCAM);
-    timeout--;
-    if (ddr_timeout_elapsed(timeout))
+    if (HAL_IsTimeoutElapsed(timeout) != 0U)
     {
       return -1;
     }
@@ -1389,7 +1374,7 @@ static bool ddr_is_host_interface_enabled(void)
 
 static int sw_selfref_entry(void)
 {
-  __IO uint32_t timeout;
+  uint64_t timeout;
   uint32_t stat;
   uint32_t operating_mode;
   uint32_t selref_type;
@@ -1402,14 +1387,13 @@ static int sw_selfref_entry(void)
    * Ensure transition to self-refresh was due to software
    * by checking also that STAT.selfref_type[1:0]=2.
    */
-  timeout = ddr_timeout_init_us(DDR_TIMEOUT_500_US);
+  timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_500_US);
 
-  while (!ddr_timeout_elapsed(timeout))
+  while (HAL_IsTimeoutElapsed(timeout) == 0U)
   {
     stat = READ_REG(DDRC->STAT);
     operating_mode = stat & DDRC_STAT_OPERATING_MODE_Msk;
     selref_type = stat & DDRC_STAT_SELFREF_TYPE_Msk;
-    timeout--;
 
     if ((operating_mode == DDRC_STAT_OPERATING_MODE_SR)
         && (selref_type == DDRC_STAT_SELFREF_TYPE_SR))
@@ -1488,15 +1472,14 @@ static int unset_qd1_qd3_update_conditions(void)
 
 static int wait_dfi_init_complete(void)
 {
-  __IO uint32_t timeout;
+  uint64_t timeout;
   uint32_t dfistat;
 
-  timeout = ddr_timeout_init_us(DDR_TIMEOUT_US_1S);
+  timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_US_1S);
   do {
     dfistat = READ_REG(DDRC->DFISTAT);
 
-    timeout--;
-    if (ddr_timeout_elapsed(timeout))
+    if (HAL_IsTimeoutElapsed(timeout) != 0U)
     {
       return -1;
     }
@@ -1507,19 +1490,18 @@ static int wait_dfi_init_complete(void)
 
 static int disable_dfi_low_power_interface(void)
 {
-  __IO uint32_t timeout;
+  uint64_t timeout;
   uint32_t dfistat;
   uint32_t stat;
 
   CLEAR_BIT(DDRC->DFILPCFG0, DDRC_DFILPCFG0_DFI_LP_EN_SR);
 
-  timeout = ddr_timeout_init_us(DDR_TIMEOUT_US_1S);
+  timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_US_1S);
   do {
     dfistat = READ_REG(DDRC->DFISTAT);
     stat = READ_REG(DDRC->STAT);
 
-    timeout--;
-    if (ddr_timeout_elapsed(timeout))
+    if (HAL_IsTimeoutElapsed(timeout) != 0U)
     {
       return -1;
     }
@@ -1554,7 +1536,7 @@ static int activate_controller(bool sr_entry)
     return -1;
   }
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   if (sr_entry)
   {
@@ -1565,7 +1547,7 @@ static int activate_controller(bool sr_entry)
     SET_BIT(DDRC->DFIMISC, DDRC_DFIMISC_DFI_INIT_COMPLETE_EN);
   }
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   if (unset_qd1_qd3_update_conditions() != 0)
   {
@@ -1577,7 +1559,7 @@ static int activate_controller(bool sr_entry)
 
 static int wait_lp3_mode(bool state)
 {
-  __IO uint32_t timeout;
+  uint64_t timeout;
   uint16_t phyinlpx;
   bool repeat_loop = false;
 
@@ -1586,12 +1568,11 @@ static int wait_lp3_mode(bool state)
   WRITE_REG(*(volatile uint32_t*)(DDRPHYC_BASE + DDRPHY_DRTUB0_UCCLKHCLKENABLES),
 	    DDRPHY_DRTUB0_UCCLKHCLKENABLES_UCCLKEN | DDRPHY_DRTUB0_UCCLKHCLKENABLES_HCLKEN);
 
-  timeout = ddr_timeout_init_us(DDR_TIMEOUT_US_1S);
+  timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_US_1S);
   do {
     phyinlpx = READ_REG(*(volatile uint32_t*)(DDRPHYC_BASE + DDRPHY_INITENG0_P0_PHYINLPX));
 
-    timeout--;
-    if (ddr_timeout_elapsed(timeout))
+    if (HAL_IsTimeoutElapsed(timeout) != 0U)
     {
       return -1;
     }
@@ -1664,6 +1645,8 @@ static int set_reg(reg_type type, const void *param)
   void *base_addr = get_base_addr(ddr_registers[type].base);
   const reg_desc *desc = ddr_registers[type].desc;
 
+  HAL_DDR_Trace(HAL_DDR_TRACE_SET_REG, (uint32_t)type);
+
   for (i = 0; i < ddr_registers[type].size; i++)
   {
     if (desc[i].par_offset == INVALID_OFFSET)
@@ -1698,7 +1681,7 @@ static int sr_loop(bool is_entry)
 #if STM32MP_LPDDR4_TYPE
   uint32_t state;
 #endif /* STM32MP_LPDDR4_TYPE */
-  __IO uint32_t timeout = ddr_timeout_init_us(DDR_TIMEOUT_1_US);
+  uint64_t timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_US_1S);
   bool repeat_loop = false;
 
   /* Wait for DDRCTRL to be out of or back to "normal/mission mode" */
@@ -1709,8 +1692,7 @@ static int sr_loop(bool is_entry)
     state = READ_REG(DDRC->STAT) & DDRC_STAT_SELFREF_STATE_Msk;
 #endif /* STM32MP_LPDDR4_TYPE */
 
-    timeout--;
-    if (ddr_timeout_elapsed(timeout))
+    if (HAL_IsTimeoutElapsed(timeout) != 0U)
     {
       return -1;
     }
@@ -1819,7 +1801,7 @@ static int sr_ssr_exit(void)
   CLEAR_BIT(RCC->DDRITFCFGR, RCC_DDRITFCFGR_DDRPHYDLP);
   SET_BIT(RCC->DDRPHYCCFGR, RCC_DDRPHYCCFGR_DDRPHYCEN);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   if (activate_controller(false) != 0)
   {
@@ -1950,7 +1932,7 @@ static int sr_hsr_set(void)
 
 static void ddr_reset(void)
 {
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
 #ifdef DDR_INTERACTIVE
   WRITE_REG(RCC->DDRCPCFGR, RCC_DDRCPCFGR_DDRCPEN | RCC_DDRCPCFGR_DDRCPLPEN |
@@ -1966,7 +1948,7 @@ static void ddr_reset(void)
   WRITE_REG(RCC->DDRCFGR, RCC_DDRCFGR_DDRCFGEN | RCC_DDRCFGR_DDRCFGLPEN |
                           RCC_DDRCFGR_DDRCFGRST);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   /* Reset release */
 #ifdef DDR_INTERACTIVE
@@ -1976,13 +1958,13 @@ static void ddr_reset(void)
   CLEAR_BIT(RCC->DDRCAPBCFGR, RCC_DDRCAPBCFGR_DDRCAPBRST);
   CLEAR_BIT(RCC->DDRCFGR, RCC_DDRCFGR_DDRCFGRST);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 }
 
 static int ddr_pll2_configure(void)
 {
 #if defined(USE_STM32MP257CXX_EMU)
-  __IO uint32_t timeout;
+  uint64_t timeout;
 
   WRITE_REG(RCC->PLL2CFGR4, RCC_PLL2CFGR4_VAL);
   WRITE_REG(RCC->PLL2CFGR1, RCC_PLL2CFGR1_VAL1);
@@ -1993,18 +1975,17 @@ static int ddr_pll2_configure(void)
   WRITE_REG(RCC->PLL2CFGR5, RCC_PLL2CFGR5_VAL);
   WRITE_REG(RCC->PLL2CFGR1, RCC_PLL2CFGR1_VAL2);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
-  timeout = ddr_timeout_init_us(DDR_TIMEOUT_US_1S);
+  timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_US_1S);
   while ((READ_REG(DDRDBG->FRAC_PLL_LOCK) & DDRDBG_FRAC_PLL_LOCK_LOCK) !=
          DDRDBG_FRAC_PLL_LOCK_LOCK)
   {
-    timeout--;
-    if (ddr_timeout_elapsed(timeout))
+    if (HAL_IsTimeoutElapsed(timeout) != 0U)
     {
       return -1;
     }
-    ddr_delay_us(DDR_DELAY_1_US);
+    HAL_DelayUs(DDR_DELAY_1_US);
   }
 #endif /* USE_STM32MP257CXX_EMU */
 
@@ -2058,14 +2039,14 @@ static int ddr_sysconf_configuration(void)
             DDRDBG_LP_DISABLE_LPI_XPI_DISABLE | DDRDBG_LP_DISABLE_LPI_DDRC_DISABLE);
   WRITE_REG(DDRDBG->BYPASS_PCLKEN, 0U);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   WRITE_REG(RCC->DDRPHYCCFGR, RCC_DDRPHYCCFGR_DDRPHYCEN);
 
   WRITE_REG(RCC->DDRCPCFGR, RCC_DDRCPCFGR_DDRCPEN | RCC_DDRCPCFGR_DDRCPLPEN);
   SET_BIT(RCC->DDRITFCFGR, RCC_DDRITFCFGR_DDRRST);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 #endif /* USE_STM32MP257CXX_EMU */
 
 #if !defined(USE_STM32MP257CXX_EMU)
@@ -2077,7 +2058,7 @@ static int ddr_sysconf_configuration(void)
   WRITE_REG(RCC->DDRPHYCCFGR, RCC_DDRPHYCCFGR_DDRPHYCEN);
   SET_BIT(RCC->DDRITFCFGR, RCC_DDRITFCFGR_DDRRST);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 #endif /* !defined(USE_STM32MP257CXX_EMU) */
 
   return 0;
@@ -2085,7 +2066,7 @@ static int ddr_sysconf_configuration(void)
 
 static int wait_refresh_update_done_ack(void)
 {
-  __IO uint32_t timeout;
+  uint64_t timeout;
   uint32_t rfshctl3;
   uint32_t refresh_update_level = DDRC_RFSHCTL3_REFRESH_UPDATE_LEVEL;
 
@@ -2101,13 +2082,12 @@ static int wait_refresh_update_done_ack(void)
     refresh_update_level = 0U;
   }
 
-  timeout = ddr_timeout_init_us(DDR_TIMEOUT_US_1S);
+  timeout = HAL_TimeoutInitUs(DDR_TIMEOUT_US_1S);
   do
   {
     rfshctl3 = READ_REG(DDRC->RFSHCTL3);
 
-    timeout--;
-    if (ddr_timeout_elapsed(timeout))
+    if (HAL_IsTimeoutElapsed(timeout) != 0U)
     {
       return -1;
     }
@@ -2126,12 +2106,12 @@ static int disable_refresh(void)
     return -1;
   }
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   CLEAR_BIT(DDRC->PWRCTL, DDRC_PWRCTL_POWERDOWN_EN |
                           DDRC_PWRCTL_SELFREF_EN);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   /*
    * manage quasi-dynamic registers modification
@@ -2142,11 +2122,11 @@ static int disable_refresh(void)
     return -1;
   }
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   CLEAR_BIT(DDRC->DFIMISC, DDRC_DFIMISC_DFI_INIT_COMPLETE_EN);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   if (unset_qd3_update_conditions() != 0)
   {
@@ -2162,7 +2142,7 @@ static int restore_refresh(uint32_t rfshctl3, uint32_t pwrctl)
   {
     CLEAR_BIT(DDRC->PWRCTL, DDRC_PWRCTL_SELFREF_SW);
 
-    ddr_delay_us(DDR_DELAY_1_US);
+    HAL_DelayUs(DDR_DELAY_1_US);
   }
 
   if ((rfshctl3 & DDRC_RFSHCTL3_DIS_AUTO_REFRESH) == 0U)
@@ -2173,21 +2153,21 @@ static int restore_refresh(uint32_t rfshctl3, uint32_t pwrctl)
       return -1;
     }
 
-    ddr_delay_us(DDR_DELAY_1_US);
+    HAL_DelayUs(DDR_DELAY_1_US);
   }
 
   if ((pwrctl & DDRC_PWRCTL_POWERDOWN_EN) != 0U)
   {
     SET_BIT(DDRC->PWRCTL, DDRC_PWRCTL_POWERDOWN_EN);
 
-    ddr_delay_us(DDR_DELAY_1_US);
+    HAL_DelayUs(DDR_DELAY_1_US);
   }
 
   if ((pwrctl & DDRC_PWRCTL_SELFREF_EN) != 0U)
   {
     SET_BIT(DDRC->PWRCTL, DDRC_PWRCTL_SELFREF_EN);
 
-    ddr_delay_us(DDR_DELAY_1_US);
+    HAL_DelayUs(DDR_DELAY_1_US);
   }
 
   /*
@@ -2199,11 +2179,11 @@ static int restore_refresh(uint32_t rfshctl3, uint32_t pwrctl)
     return -1;
   }
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   SET_BIT(DDRC->DFIMISC, DDRC_DFIMISC_DFI_INIT_COMPLETE_EN);
 
-  ddr_delay_us(DDR_DELAY_1_US);
+  HAL_DelayUs(DDR_DELAY_1_US);
 
   if (unset_qd3_update_conditions() != 0)
   {
@@ -2214,6 +2194,30 @@ static int restore_refresh(uint32_t rfshctl3, uint32_t pwrctl)
 }
 
 #ifdef DDR_INTERACTIVE
+/* output of HAL_DDR_Dump_Reg(), printf when NULL */
+static HAL_DDR_RegOutputTypeDef reg_output;
+
+#define REG_NAME_NB (ARRAY_SIZE(ddr_reg_desc) + ARRAY_SIZE(ddr_timing_desc) + \
+                     ARRAY_SIZE(ddr_perf_desc) + ARRAY_SIZE(ddr_map_desc) + \
+                     ARRAY_SIZE(phy_uib_desc) + ARRAY_SIZE(phy_uia_desc) + \
+                     ARRAY_SIZE(phy_uim_desc) + ARRAY_SIZE(phy_uis_desc) + \
+                     ARRAY_SIZE(pll_settings_desc) + ARRAY_SIZE(ddr_dyn_desc))
+
+/* type and index of reg_name_entry, and size of ddr_reg_info, are uint8_t */
+#define REG_DESC_FITS(a) (ARRAY_SIZE(a) <= UINT8_MAX)
+_Static_assert(REG_DESC_FITS(ddr_registers), "too many register types");
+_Static_assert(REG_DESC_FITS(ddr_reg_desc) && REG_DESC_FITS(ddr_timing_desc) &&
+               REG_DESC_FITS(ddr_perf_desc) && REG_DESC_FITS(ddr_map_desc) &&
+               REG_DESC_FITS(phy_uib_desc) && REG_DESC_FITS(phy_uia_desc) &&
+               REG_DESC_FITS(phy_uim_desc) && REG_DESC_FITS(phy_uis_desc) &&
+               REG_DESC_FITS(pll_settings_desc) &&
+               REG_DESC_FITS(ddr_dyn_desc),
+               "register descriptor array too large");
+
+/* all the register names, sorted without case at the first search */
+static reg_name_entry reg_name_index[REG_NAME_NB];
+static unsigned int reg_name_nb;
+
 void HAL_DDR_Convert_Case(const char *in_str, char *out_str, bool ToUpper)
 {
   while((*out_str = ToUpper? toupper(*in_str) : tolower(*in_str)))
@@ -2225,13 +2229,33 @@ void HAL_DDR_Convert_Case(const char *in_str, char *out_str, bool ToUpper)
   return;
 }
 
-static void dump_reg_desc(unsigned long base_addr, const reg_desc *desc,
-                          bool save)
+static void dump_reg_desc(const ddr_reg_info *info, unsigned long base_addr,
+                          const reg_desc *desc, bool save)
 {
   uintptr_t ptr;
+  uint32_t value;
   char reg_name[strlen(desc->name) + 1];
   char output_dest[50] = "";
 
+  if (reg_output)
+  {
+    ptr = (uintptr_t)(base_addr + desc->offset);
+    if (base_addr != (unsigned long)DDRC_BASE)
+    {
+      value = (uint32_t)*(int *)ptr;
+    }
+    else if (save && (strcmp("SWCTL", desc->name) == 0))
+    {
+      value = 0U;
+    }
+    else
+    {
+      value = READ_REG(*(volatile uint32_t*)ptr);
+    }
+    reg_output(base_name[info->base], info->name, desc->name, value);
+    return;
+  }
+
   if (save)
   {
     if (base_addr == (uint32_t)DDRC_BASE)
@@ -2290,6 +2314,24 @@ static void dump_pll_desc(bool save)
   PLL2.SSM_SPREAD = DDR_PLL_SSM_SPREAD;
   PLL2.SSM_DIVVAL = DDR_PLL_SSM_DIVVAL;
 
+  if (reg_output)
+  {
+    const char *pll = base_name[BASE_DDR_PLL];
+
+    reg_output(pll, pll, "SOURCE", PLL2.PLLSource);
+    reg_output(pll, pll, "MODE", PLL2.PLLMode);
+    reg_output(pll, pll, "FBDIV", PLL2.FBDIV);
+    reg_output(pll, pll, "FREFDIV", PLL2.FREFDIV);
+    reg_output(pll, pll, "FRACIN", PLL2.FRACIN);
+    reg_output(pll, pll, "POSTDIV1", PLL2.POSTDIV1);
+    reg_output(pll, pll, "POSTDIV2", PLL2.POSTDIV2);
+    reg_output(pll, pll, "STATE", PLL2.PLLState);
+    reg_output(pll, pll, "SSM_MODE", PLL2.SSM_Mode);
+    reg_output(pll, pll, "SSM_SPREAD", PLL2.SSM_SPREAD);
+    reg_output(pll, pll, "SSM_DIVVAL", PLL2.SSM_DIVVAL);
+    return;
+  }
+
   if (save)
   {
     sprintf(output_dest, "#define DDR_PLL_");
@@ -2367,66 +2409,151 @@ static void dump_param_desc(unsigned long par_addr, const reg_desc *desc)
 #endif
 }
 
-static const reg_desc *found_reg(const char *name, reg_type *type)
+/* compare without case at most len characters, as strncmp() */
+static int name_cmp(const char *str1, const char *str2, size_t len)
+{
+  int diff;
+
+  for (; len != 0U; len--, str1++, str2++)
+  {
+    diff = toupper((unsigned char)*str1) - toupper((unsigned char)*str2);
+    if ((diff != 0) || (*str1 == '\0'))
+    {
+      return diff;
+    }
+  }
+
+  return 0;
+}
+
+static const char *reg_name(const reg_name_entry *entry)
+{
+  return ddr_registers[entry->type].desc[entry->index].name;
+}
+
+/* name order, then ddr_registers order for the same name */
+static int reg_name_entry_cmp(const void *p1, const void *p2)
+{
+  const reg_name_entry *entry1 = p1;
+  const reg_name_entry *entry2 = p2;
+  int diff = name_cmp(reg_name(entry1), reg_name(entry2), SIZE_MAX);
+
+  if (diff == 0)
+  {
+    diff = (entry1->type != entry2->type) ? entry1->type - entry2->type :
+                                            entry1->index - entry2->index;
+  }
+
+  return diff;
+}
+
+static void build_reg_name_index(void)
 {
   unsigned int i, j;
-  const reg_desc *desc;
-  char reg_name[strlen(name) + 1];
 
+  reg_name_nb = 0;
   for (i = 0; i < ARRAY_SIZE(ddr_registers); i++)
   {
-    desc = ddr_registers[i].desc;
     for (j = 0; j < ddr_registers[i].size; j++)
     {
-      /* Compare string lengths to avoid data corruption */
-      if (strlen(desc[j].name) > strlen(name))
-      {
-        continue;
-      }
-
-      HAL_DDR_Convert_Case(desc[j].name, reg_name, true); /* convert to upper case */
-      if (strcmp(name, reg_name) == 0)
-      {
-        *type = i;
-        return &desc[j];
-      }
+      reg_name_index[reg_name_nb].type = (uint8_t)i;
+      reg_name_index[reg_name_nb].index = (uint8_t)j;
+      reg_name_nb++;
     }
   }
 
-  *type = REG_TYPE_NB;
-
-  return NULL;
+  qsort(reg_name_index, reg_name_nb, sizeof(reg_name_index[0]),
+        reg_name_entry_cmp);
 }
 
-static base_type get_filter(const char *name)
+static void print_reg_name(const char *name)
 {
-  char type[strlen(name) + 1];
+  for (; *name != '\0'; name++)
+  {
+    putchar(tolower((unsigned char)*name));
+  }
+}
 
-  HAL_DDR_Convert_Case(name, type, 0); /* convert to lower case */
+/*
+ * Binary search of the register name, without case. When no name is equal,
+ * a name which is the only one to start with the given name is accepted; the
+ * names are listed when several ones start with it.
+ */
+static const reg_desc *found_reg(const char *name, reg_type *type)
+{
+  size_t len = strlen(name);
+  unsigned int first = 0;
+  unsigned int last;
+  unsigned int mid;
+  unsigned int i;
+  const reg_name_entry *entry;
 
-  if (strcmp(type, base_name[BASE_DDRCTRL]) == 0)
+  if (reg_name_nb == 0U)
   {
-    return BASE_DDRCTRL;
+    build_reg_name_index();
   }
-  else if (strcmp(type, base_name[BASE_PHY_UI_BASIC]) == 0)
+
+  /* first name not lower than name */
+  last = reg_name_nb;
+  while (first < last)
   {
-    return BASE_PHY_UI_BASIC;
+    mid = (first + last) / 2U;
+    if (name_cmp(reg_name(&reg_name_index[mid]), name, SIZE_MAX) < 0)
+    {
+      first = mid + 1U;
+    }
+    else
+    {
+      last = mid;
+    }
   }
-  else if (strcmp(type, base_name[BASE_PHY_UI_ADVANCED]) == 0)
+
+  /* names starting with name: [first, last) */
+  for (last = first; last < reg_name_nb; last++)
   {
-    return BASE_PHY_UI_ADVANCED;
+    if (name_cmp(reg_name(&reg_name_index[last]), name, len) != 0)
+    {
+      break;
+    }
   }
-  else if (strcmp(type, base_name[BASE_PHY_UI_MODE_REGISTER]) == 0)
+
+  *type = REG_TYPE_NB;
+
+  if (first == last)
   {
-    return BASE_PHY_UI_MODE_REGISTER;
+    return NULL;
   }
-  else if (strcmp(type, base_name[BASE_PHY_UI_SWIZZLE]) == 0)
+
+  entry = &reg_name_index[first];
+  if ((name_cmp(reg_name(entry), name, SIZE_MAX) != 0) &&
+      (last - first > 1U))
   {
-    return BASE_PHY_UI_SWIZZLE;
+    printf("%s is ambiguous:", name);
+    for (i = first; i < last; i++)
+    {
+      putchar(' ');
+      print_reg_name(reg_name(&reg_name_index[i]));
+    }
+    printf("\n\r");
+
+    return NULL;
   }
-  else if (strcmp(type, base_name[BASE_DDR_PLL]) == 0)
+
+  *type = entry->type;
+
+  return &ddr_registers[entry->type].desc[entry->index];
+}
+
+static base_type get_filter(const char *name)
+{
+  unsigned int i;
+
+  for (i = 0; i < BASE_NONE; i++)
   {
-    return BASE_DDR_PLL;
+    if (name_cmp(name, base_name[i], SIZE_MAX) == 0)
+    {
+      return (base_type)i;
+    }
   }
 
   return BASE_NONE;
@@ -2464,23 +2591,28 @@ HAL_StatusTypeDef HAL_DDR_Dump_Reg(const char *name, bool save)
   {
     p_base = ddr_registers[i].base;
     p_name = ddr_registers[i].name;
-    if (!name || (filter == p_base || !strcmp(name, p_name)) || save)
+    if (!name || (filter == p_base || !name_cmp(name, p_name, SIZE_MAX)) ||
+        save)
     {
       result = HAL_OK;
       desc = ddr_registers[i].desc;
       base_addr = (unsigned long)get_base_addr(p_base);
 
-      if (save)
+      /* with reg_output, the section is given with each register */
+      if (reg_output == NULL)
       {
-        if (i == REG_DYN)
+        if (save)
         {
-          printf("\n/* /!\\ No need to copy DDR dynamic registers to conf file */\n\r");
+          if (i == REG_DYN)
+          {
+            printf("\n/* /!\\ No need to copy DDR dynamic registers to conf file */\n\r");
+          }
+          printf("\n/* %s.%s */\n\r", base_name[p_base], p_name);
+        }
+        else
+        {
+          printf("==%s.%s==\n\r", base_name[p_base], p_name);
         }
-        printf("\n/* %s.%s */\n\r", base_name[p_base], p_name);
-      }
-      else
-      {
-        printf("==%s.%s==\n\r", base_name[p_base], p_name);
       }
 
       if (i == PLL_SETTINGS)
@@ -2491,7 +2623,7 @@ HAL_StatusTypeDef HAL_DDR_Dump_Reg(const char *name, bool save)
       {
         for (j = 0; j < ddr_registers[i].size; j++)
         {
-          dump_reg_desc(base_addr, &desc[j], save);
+          dump_reg_desc(&ddr_registers[i], base_addr, &desc[j], save);
         }
       }
     }
@@ -2508,7 +2640,7 @@ HAL_StatusTypeDef HAL_DDR_Dump_Reg(const char *name, bool save)
     {
       p_base = ddr_registers[type].base;
       base_addr = (unsigned long)get_base_addr(p_base);
-      dump_reg_desc(base_addr, desc, false);
+      dump_reg_desc(&ddr_registers[type], base_addr, desc, false);
       result = HAL_OK;
     }
   }
@@ -2520,6 +2652,12 @@ HAL_StatusTypeDef HAL_DDR_Dump_Reg(const char *name, bool save)
   return result;
 }
 
+/* NULL restores the printf output */
+void HAL_DDR_Set_Reg_Output(HAL_DDR_RegOutputTypeDef output)
+{
+  reg_output = output;
+}
+
 void HAL_DDR_Edit_Reg(char *name, char *string)
 {
   uint32_t value;
@@ -2527,13 +2665,11 @@ void HAL_DDR_Edit_Reg(char *name, char *string)
   const reg_desc *desc;
   void *base_addr;
   char *end_ptr;
-  char reg_name[strlen(name) + 1];
   char reg_value[strlen(string) + 1];
 
-  HAL_DDR_Convert_Case(name, reg_name, 1); /* convert to upper case */
   HAL_DDR_Convert_Case(string, reg_value, 0); /* convert to lower case */
 
-  desc = found_reg(reg_name, &type);
+  desc = found_reg(name, &type);
 
   if (!desc)
   {
@@ -2556,25 +2692,29 @@ void HAL_DDR_Edit_Reg(char *name, char *string)
 
   base_addr = get_base_addr(ddr_registers[type].base);
 
-  HAL_DDR_Convert_Case(desc->name, reg_name, 0); /* convert to lower case */
-
-  if (base_addr == (void *)DDRC_BASE)
   {
-    WRITE_REG(*(volatile uint32_t*)(base_addr + desc->offset), value);
+    char reg_name[strlen(desc->name) + 1];
+
+    HAL_DDR_Convert_Case(desc->name, reg_name, 0); /* convert to lower case */
+
+    if (base_addr == (void *)DDRC_BASE)
+    {
+      WRITE_REG(*(volatile uint32_t*)(base_addr + desc->offset), value);
 
 #ifdef __AARCH64__
-    printf("%s= 0x%08X\n\r", reg_name,
-           READ_REG(*(volatile uint32_t*)(base_addr + desc->offset)));
+      printf("%s= 0x%08X\n\r", reg_name,
+             READ_REG(*(volatile uint32_t*)(base_addr + desc->offset)));
 #else
-    printf("%s= 0x%08lX\n\r", reg_name,
-           READ_REG(*(volatile uint32_t*)(base_addr + desc->offset)));
+      printf("%s= 0x%08lX\n\r", reg_name,
+             READ_REG(*(volatile uint32_t*)(base_addr + desc->offset)));
 #endif
-  }
-  else
-  {
-    *(int *)(base_addr + desc->offset) = value;
+    }
+    else
+    {
+      *(int *)(base_addr + desc->offset) = value;
 
-    printf("%s= 0x%08X\n\r", reg_name, *(int *)(base_addr + desc->offset));
+      printf("%s= 0x%08X\n\r", reg_name, *(int *)(base_addr + desc->offset));
+    }
   }
 }
 
@@ -2646,7 +2786,7 @@ HAL_StatusTypeDef HAL_DDR_Dump_Param(HAL_DDR_ConfigTypeDef *config,
 
     p_base = ddr_registers[i].base;
     p_name = ddr_registers[i].name;
-    if (!name || (filter == p_base || !strcmp(name, p_name)))
+    if (!name || (filter == p_base || !name_cmp(name, p_name, SIZE_MAX)))
     {
       result = HAL_OK;
       desc = ddr_registers[i].desc;
@@ -2727,23 +2867,11 @@ __weak bool HAL_DDR_Interactive(__attribute__((unused))HAL_DDR_InteractStepTypeD
 #define INTERACTIVE(step) HAL_DDR_Interactive(step)
 #endif /* DDR_INTERACTIVE */
 
-/* Exported functions ---------------------------------------------------------*/
-
-/** @defgroup DDR_Exported_Functions DDR Exported Functions
-  * @{
-  */
-
-
-/**
-  * @brief  DDR init sequence, including
-  *         - reset/clock/power management (i.e. access to other IPs),
-  *         - DDRCTRL and DDRPHY configuration and initialization,
-  *         - self-refresh mode setup,
-  *         - data/addr tests execution after training.
-  * @param  DDR initialisation structure
-  * @retval None.
-  */
-HAL_StatusTypeDef HAL_DDR_Init(DDR_InitTypeDef *iddr)
+/*******************************************************************************
+ * DDR init sequence of HAL_DDR_Init(), with all its return paths.
+ * restore: skip the training when valid training results are saved.
+ ******************************************************************************/
+static HAL_StatusTypeDef ddr_init(DDR_InitTypeDef *iddr, bool restore)
 {
   int iret = -1;
   uint32_t uret;
@@ -2848,6 +2976,8 @@ HAL_StatusTypeDef HAL_DDR_Init(DDR_InitTypeDef *iddr)
 start:
 #endif /* DDR_INTERACTIVE */
 
+  HAL_DDR_Trace(HAL_DDR_TRACE_RESET, iddr->wakeup_from_standby ? 1U : 0U);
+
   if (iddr->wakeup_from_standby)
   {
     WRITE_REG(RCC->DDRCPCFGR, RCC_DDRCPCFGR_DDRCPEN | RCC_DDRCPCFGR_DDRCPLPEN |
@@ -2863,14 +2993,14 @@ start:
     CLEAR_BIT(RCC->DDRITFCFGR, RCC_DDRITFCFGR_DDRPHYDLP);
     SET_BIT(RCC->DDRPHYCCFGR, RCC_DDRPHYCCFGR_DDRPHYCEN);
 
-    ddr_delay_us(DDR_DELAY_1_US);
+    HAL_DelayUs(DDR_DELAY_1_US);
 
     /* Disable IO retention */
     SET_BIT(PWR->CR11, PWR_CR11_DDRRETDIS);
 
-    ddr_delay_us(DDR_DELAY_1_US);
+    HAL_DelayUs(DDR_DELAY_1_US);
     CLEAR_BIT(RCC->DDRCAPBCFGR, RCC_DDRCAPBCFGR_DDRCAPBRST);
-    ddr_delay_us(DDR_DELAY_1_US);
+    HAL_DelayUs(DDR_DELAY_1_US);
 
     if (ddr_pll2_configure() != 0)
     {
@@ -2888,6 +3018,8 @@ start:
     }
 #endif /* DDR_INTERACTIVE */
 
+    HAL_DDR_Trace(HAL_DDR_TRACE_SYSCONF, 0U);
+
     if (ddr_sysconf_configuration() != 0)
     {
       return HAL_ERROR;
@@ -2902,6 +3034,18 @@ start:
   static_ddr_config.c_reg.PWRCTL |= DDRC_PWRCTL_SELFREF_SW;
 #endif /* STM32MP_LPDDR4_TYPE */
 
+  /* PHY settings first: the saved registers are checked against them */
+  if ((set_reg(PHY_UI_BASIC, &static_ddr_config.p_uib) != 0) ||
+      (set_reg(PHY_UI_ADVANCED, &static_ddr_config.p_uia) != 0) ||
+      (set_reg(PHY_UI_MODE_REGISTER, &static_ddr_config.p_uim) != 0) ||
+      (set_reg(PHY_UI_SWIZZLE, &static_ddr_config.p_uis) != 0))
+  {
+    return HAL_ERROR;
+  }
+
+  restore = restore && !iddr->wakeup_from_standby &&
+            (ddrphy_phyinit_checkretregs() == 0);
+
   if ((set_reg(REG_REG, &static_ddr_config.c_reg) != 0) ||
       (set_reg(REG_TIMING, &static_ddr_config.c_timing) != 0) ||
       (set_reg(REG_MAP, &static_ddr_config.c_map) != 0) ||
@@ -2910,6 +3054,18 @@ start:
     return HAL_ERROR;
   }
 
+  if (restore)
+  {
+    /*
+     * The training firmware, which initializes the DRAM devices (DevInit:
+     * reset, mode registers, ZQ calibration), is not executed: DDRCTRL does
+     * this initialization, programmed while its core is still in reset.
+     */
+    CLEAR_BIT(DDRC->INIT0, DDRC_INIT0_SKIP_DRAM_INIT_Msk);
+  }
+
+  HAL_DDR_Trace(HAL_DDR_TRACE_CTL_INIT, 0U);
+
 #ifdef DDR_INTERACTIVE
   if (INTERACTIVE(STEP_CTL_INIT))
   {
@@ -2928,14 +3084,6 @@ start:
     }
   }
 
-  if ((set_reg(PHY_UI_BASIC, &static_ddr_config.p_uib) != 0) ||
-      (set_reg(PHY_UI_ADVANCED, &static_ddr_config.p_uia) != 0) ||
-      (set_reg(PHY_UI_MODE_REGISTER, &static_ddr_config.p_uim) != 0) ||
-      (set_reg(PHY_UI_SWIZZLE, &static_ddr_config.p_uis) != 0))
-  {
-    return HAL_ERROR;
-  }
-
   if (iddr->wakeup_from_standby)
   {
     WRITE_REG(RCC->DDRCPCFGR, RCC_DDRCPCFGR_DDRCPEN | RCC_DDRCPCFGR_DDRCPLPEN);
@@ -2948,6 +3096,7 @@ start:
 
     if (iret == 0)
     {
+      HAL_DDR_Trace(HAL_DDR_TRACE_RESTORE, 1U);
       iret = ddrphy_phyinit_restore_sequence();
     }
 
@@ -2957,6 +3106,23 @@ start:
       return HAL_ERROR;
     }
   }
+  else if (restore)
+  {
+    /*
+     * Initialize DDR by skipping training, then restore the training results
+     * saved by a previous initialization with the same PHY settings; the
+     * DRAM devices are initialized by DDRCTRL (INIT0.SKIP_DRAM_INIT cleared)
+     */
+    iddr->training_restored = true;
+
+    iret = ddrphy_phyinit_sequence(true, false);
+
+    if (iret == 0)
+    {
+      HAL_DDR_Trace(HAL_DDR_TRACE_RESTORE, 0U);
+      iret = ddrphy_phyinit_restore_sequence();
+    }
+  }
   else
   {
 #ifdef STM32MP_DISABLE_SAVE_RETENTION_REGISTERS
@@ -2972,6 +3138,8 @@ start:
 #endif /* STM32MP_DISABLE_SAVE_RETENTION_REGISTERS */
   }
 
+  HAL_DDR_Trace(HAL_DDR_TRACE_PHY_INIT, (uint32_t)iret);
+
   if (iret != 0)
   {
     return HAL_ERROR;
@@ -2989,6 +3157,8 @@ start:
     return HAL_ERROR;
   }
 
+  HAL_DDR_Trace(HAL_DDR_TRACE_REFRESH, 0U);
+
   if (iddr->wakeup_from_standby)
   {
     /* SW self refresh entry prequested */
@@ -3014,6 +3184,8 @@ start:
 
   enable_axi_port();
 
+  HAL_DDR_Trace(HAL_DDR_TRACE_READY, 0U);
+
 #ifdef DDR_INTERACTIVE
   if (INTERACTIVE(STEP_DDR_READY))
   {
@@ -3091,6 +3263,45 @@ start:
   return HAL_DDR_SR_SetMode(mode);
 }
 
+/* Exported functions ---------------------------------------------------------*/
+
+/** @defgroup DDR_Exported_Functions DDR Exported Functions
+  * @{
+  */
+
+
+/**
+  * @brief  DDR init sequence, including
+  *         - reset/clock/power management (i.e. access to other IPs),
+  *         - DDRCTRL and DDRPHY configuration and initialization,
+  *         - self-refresh mode setup,
+  *         - data/addr tests execution after training,
+  *         - full training when restored training results fail the tests.
+  * @param  DDR initialisation structure
+  * @retval None.
+  */
+HAL_StatusTypeDef HAL_DDR_Init(DDR_InitTypeDef *iddr)
+{
+  HAL_StatusTypeDef ret;
+
+  HAL_DDR_Trace(HAL_DDR_TRACE_INIT, iddr->wakeup_from_standby ? 1U : 0U);
+
+  iddr->training_restored = false;
+
+  ret = ddr_init(iddr, iddr->restore_training);
+
+  if ((ret != HAL_OK) && iddr->training_restored)
+  {
+    /* Restored training results rejected by the tests: full training */
+    iddr->training_restored = false;
+    ret = ddr_init(iddr, false);
+  }
+
+  HAL_DDR_Trace(HAL_DDR_TRACE_INIT_END, (uint32_t)ret);
+
+  return ret;
+}
+
 /**
   * @brief  Enable DDR Self-Refresh, when entering in CSTOP.
   * @param  zq0cr0_zdata IO calibration value.
@@ -3292,6 +3503,102 @@ HAL_StatusTypeDef HAL_DDR_SetRetentionAreaBase(unsigned long base)
   return HAL_OK;
 }
 
+/*
+ * Copy the critical delay differences of a channel, from its cdd_* fields of
+ * the message block, ordered by type then from the highest rank pair.
+ * Returns the field following the last one.
+ */
+static const int8_t *get_training_cdd(const int8_t *field,
+                                      int8_t cdd[HAL_DDR_CDD_NB]
+                                                [HAL_DDR_TRAINING_RANK_MAX]
+                                                [HAL_DDR_TRAINING_RANK_MAX])
+{
+#if STM32MP_LPDDR4_TYPE
+  static const uint8_t type[] = {HAL_DDR_CDD_RR, HAL_DDR_CDD_RW,
+                                 HAL_DDR_CDD_WR, HAL_DDR_CDD_WW};
+  const int rank_max = 2;
+#else /* STM32MP_LPDDR4_TYPE */
+  static const uint8_t type[] = {HAL_DDR_CDD_RR, HAL_DDR_CDD_WW,
+                                 HAL_DDR_CDD_RW, HAL_DDR_CDD_WR};
+  const int rank_max = 4;
+#endif /* STM32MP_LPDDR4_TYPE */
+  unsigned int t;
+  int from;
+  int to;
+
+  for (t = 0; t < sizeof(type); t++)
+  {
+    for (from = rank_max - 1; from >= 0; from--)
+    {
+      for (to = rank_max - 1; to >= 0; to--)
+      {
+        /* no same rank delay difference in RR and WW */
+        if ((from == to) &&
+            ((type[t] == HAL_DDR_CDD_RR) || (type[t] == HAL_DDR_CDD_WW)))
+        {
+          continue;
+        }
+
+        cdd[type[t]][from][to] = *field++;
+      }
+    }
+  }
+
+  return field;
+}
+
+/**
+  * @brief  Get the training results of a P-state, read from the message block
+  *         after the last training (not available when the training was
+  *         skipped or the saved results restored).
+  * @param  pstate P-state number.
+  * @param  result training results.
+  * @retval HAL status.
+  */
+HAL_StatusTypeDef HAL_DDR_GetTrainingResult(uint32_t pstate,
+                                            HAL_DDR_TrainingResultTypeDef *result)
+{
+  const struct pmu_smb_ddr_1d *res;
+  uint8_t cs;
+
+  if ((pstate >= (uint32_t)NB_PS) || !res_ddr_1d_read[pstate])
+  {
+    return HAL_ERROR;
+  }
+
+  res = &res_ddr_1d[pstate];
+  memset(result, 0, sizeof(*result));
+
+  result->revision = res->pmurevision;
+  result->cs_test_fail = res->cstestfail;
+
+#if STM32MP_LPDDR4_TYPE
+  result->channel_nb = 2U;
+  cs = mb_ddr_1d[pstate].cspresentcha & 0x3U;
+  (void)get_training_cdd(&res->cdd_cha_rr_1_0, result->cdd[0]);
+  (void)get_training_cdd(&res->cdd_chb_rr_1_0, result->cdd[1]);
+#else /* STM32MP_LPDDR4_TYPE */
+  result->channel_nb = 1U;
+  cs = mb_ddr_1d[pstate].cspresent & 0xFU;
+  (void)get_training_cdd(&res->cdd_rr_3_2, result->cdd[0]);
+#endif /* STM32MP_LPDDR4_TYPE */
+
+  for (; cs != 0U; cs >>= 1)
+  {
+    result->rank_nb += cs & 1U;
+  }
+
+#if STM32MP_DDR4_TYPE
+  /* 2 nibbles per active byte */
+  result->vref_nb = (uint8_t)MIN(2 * (userinputbasic.numactivedbytedfi0 +
+                                      userinputbasic.numactivedbytedfi1),
+                                 (int)HAL_DDR_TRAINING_NIBBLE_MAX);
+  memcpy(result->vref, &res->vrefdqr0nib0, sizeof(result->vref));
+#endif /* STM32MP_DDR4_TYPE */
+
+  return HAL_OK;
+}
+
 /**
   * @}
   */
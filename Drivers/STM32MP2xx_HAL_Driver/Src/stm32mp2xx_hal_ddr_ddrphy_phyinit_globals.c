@@ -19,6 +19,12 @@ struct user_input_swizzle userinputswizzle;
 struct pmu_smb_ddr_1d mb_ddr_1d[NB_PS];
 /* Shadow of 1D message block. Used by PhyInit to track user changes to the data structure */
 struct pmu_smb_ddr_1d shdw_ddr_1d[NB_PS];
+/*
+ * Output fields of the 1D message block, read after the training of each PState, the other
+ * fields are zero. res_ddr_1d_read is set when they are read.
+ */
+struct pmu_smb_ddr_1d res_ddr_1d[NB_PS];
+bool res_ddr_1d_read[NB_PS];
 
 /*
  * Represent the value stored in Step C into the register with the same name.
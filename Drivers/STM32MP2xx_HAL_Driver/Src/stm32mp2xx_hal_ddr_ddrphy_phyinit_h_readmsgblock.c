@@ -18,9 +18,11 @@
  * -# Isolate the APB access from the internal CSRs by setting the MicroContMuxSel CSR to 1.
  * -# If training is required at another frequency, repeat the operations starting at step (E)
  *
+ * \param pstate the P-state trained by the firmware
+ *
  * \return void
  */
-void ddrphy_phyinit_h_readmsgblock(void)
+void ddrphy_phyinit_h_readmsgblock(int pstate)
 {
 	VERBOSE("%s Start\n", __func__);
 
@@ -28,7 +30,7 @@ void ddrphy_phyinit_h_readmsgblock(void)
 	mmio_write_16((uintptr_t)(DDRPHYC_BASE + 4 * (TAPBONLY | CSR_MICROCONTMUXSEL_ADDR)), 0x0U);
 
 	/* 2. Read the Firmware Message Block to obtain the results from the training */
-	ddrphy_phyinit_usercustom_h_readmsgblock();
+	ddrphy_phyinit_usercustom_h_readmsgblock(pstate);
 
 	/*
 	 * 3. Isolate the APB access from the internal CSRs by setting the MicroContMuxSel CSR to 1
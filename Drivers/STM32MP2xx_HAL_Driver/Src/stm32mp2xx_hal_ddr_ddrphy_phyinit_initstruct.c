@@ -58,7 +58,10 @@ void ddrphy_phyinit_initstruct(void)
 					 * Set reserved00[6:0] = 0 (Reserved; must be set to 0)
 					 */
 
-#ifdef USE_STM32MP257CXX_EMU
+#if defined(STM32MP_DDR_HDTCTRL)
+	/* training firmware messages, lower values add streaming messages */
+	uint8_t hdtctrl = STM32MP_DDR_HDTCTRL;
+#elif defined(USE_STM32MP257CXX_EMU)
 #if STM32MP_DDR3_TYPE
 	uint8_t hdtctrl = 0xFU;
 #elif STM32MP_DDR4_TYPE
@@ -66,9 +69,9 @@ void ddrphy_phyinit_initstruct(void)
 #elif STM32MP_LPDDR4_TYPE
 	uint8_t hdtctrl = 0xC8U;
 #endif /* STM32MP_LPDDR4_TYPE */
-#else /* USE_STM32MP257CXX_EMU */
+#else /* STM32MP_DDR_HDTCTRL */
 	uint8_t hdtctrl = 0xFFU;
-#endif /* USE_STM32MP257CXX_EMU */
+#endif /* STM32MP_DDR_HDTCTRL */
 
 #if STM32MP_DDR3_TYPE || STM32MP_DDR4_TYPE
 	uint8_t cspresent = 0x01U;	/*
@@ -477,6 +480,10 @@ void ddrphy_phyinit_initstruct(void)
 
 		/* Zero out struct contents */
 		memset((void *) &shdw_ddr_1d[myps], 0, sizeof(struct pmu_smb_ddr_1d));
+
+		/* No training result until the next training */
+		memset((void *) &res_ddr_1d[myps], 0, sizeof(struct pmu_smb_ddr_1d));
+		res_ddr_1d_read[myps] = false;
 	} /* myps */
 
 	VERBOSE("%s End\n", __func__);
@@ -12,7 +12,9 @@
  * programing in any function during PHY initialization.
  */
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "stm32mp2xx_hal_ddr_ddrphy_phyinit.h"
 
@@ -29,15 +31,45 @@
 #define MAX_NUM_RET_REGS	283
 #endif /* STM32MP_LPDDR4_TYPE */
 
+/*
+ * Header of the saved registers, to use them after a cold boot: layout
+ * version, signature of the PHY settings used for the training and CRC-32
+ * of the saved registers.
+ */
+struct retreg_header {
+	int size;		/* Number of registers saved */
+	uint32_t version;	/* RETREG_VERSION */
+	uint32_t settings;	/* CRC-32 of the PhyInit user input structures */
+	uint32_t crc;		/* CRC-32 of the saved address/value pairs */
+};
+
+#define RETREG_VERSION	0x52455401U
+
 /*
  * Array of Address/value pairs used to store register values for the purpose
  * of retention restore.
  */
-#define RETREG_AREA	((MAX_NUM_RET_REGS + 1) * sizeof(struct reg_addr_val))
+#define RETREG_AREA	(sizeof(struct retreg_header) + \
+			 (MAX_NUM_RET_REGS + 1) * sizeof(struct reg_addr_val))
 #define RETREG_BASE	(RETRAM_BASE + RETRAM_SIZE - RETREG_AREA)
 
-static int *retregsize = (int *)(RETREG_BASE);
-static struct reg_addr_val *retreglist = (struct reg_addr_val *)(RETREG_BASE + sizeof(int));
+static struct retreg_header *retreghdr = (struct retreg_header *)(RETREG_BASE);
+static struct reg_addr_val *retreglist =
+	(struct reg_addr_val *)(RETREG_BASE + sizeof(struct retreg_header));
+
+/*
+ * Open-addressed hash index of retreglist: 0 for a free slot, else index + 1
+ * of the register in the array, which keeps the tracking order.
+ */
+#define RETREG_HASH_BITS	10
+#define RETREG_HASH_SIZE	(1U << RETREG_HASH_BITS)
+#define RETREG_HASH(adr)	(((adr) * 0x9E3779B1U) >> (32 - RETREG_HASH_BITS))
+
+#if (MAX_NUM_RET_REGS + 1) > (RETREG_HASH_SIZE / 2)
+#error "RETREG_HASH_BITS too small for MAX_NUM_RET_REGS"
+#endif
+
+static uint16_t retreghash[RETREG_HASH_SIZE];
 
 static int numregsaved; /* Current Number of registers saved. */
 static int tracken = 1; /* Enabled tracking of registers */
@@ -58,12 +90,72 @@ int ddrphy_phyinit_setretreglistbase(unsigned long base)
   /* Restore intial value */
   *value = save;
 
-  retregsize = (int *)base;
-  retreglist = (struct reg_addr_val *)(base + 4);
+  retreghdr = (struct retreg_header *)base;
+  retreglist = (struct reg_addr_val *)(base + sizeof(struct retreg_header));
+
+  /* The index and the count refer to the previous list */
+  memset(retreghash, 0, sizeof(retreghash));
+  numregsaved = 0;
 
   return 0;
 }
 
+static uint32_t retreg_crc32(uint32_t crc, const void *buf, size_t len)
+{
+	const uint8_t *p = buf;
+	int bit;
+
+	while (len-- != 0U) {
+		crc ^= *p++;
+		for (bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+		}
+	}
+
+	return crc;
+}
+
+/* Signature of the PHY settings: the saved training results depend on them */
+static uint32_t retreg_settings(void)
+{
+	uint32_t crc = 0xFFFFFFFFU;
+
+	crc = retreg_crc32(crc, &userinputbasic, sizeof(userinputbasic));
+	crc = retreg_crc32(crc, &userinputadvanced, sizeof(userinputadvanced));
+	crc = retreg_crc32(crc, &userinputmoderegister, sizeof(userinputmoderegister));
+	crc = retreg_crc32(crc, &userinputswizzle, sizeof(userinputswizzle));
+
+	return ~crc;
+}
+
+static uint32_t retreg_crc(int size)
+{
+	return ~retreg_crc32(0xFFFFFFFFU, retreglist,
+			     (size_t)size * sizeof(struct reg_addr_val));
+}
+
+/*
+ * Checks the saved registers before a restore without retention (cold boot):
+ * they must have been saved with the current layout and PHY settings, and be
+ * unchanged since.
+ *
+ * \return 0 when the saved registers are valid.
+ */
+int ddrphy_phyinit_checkretregs(void)
+{
+	if ((retreghdr->version != RETREG_VERSION) ||
+	    (retreghdr->size <= 0) || (retreghdr->size > MAX_NUM_RET_REGS + 1)) {
+		return -1;
+	}
+
+	if ((retreghdr->settings != retreg_settings()) ||
+	    (retreghdr->crc != retreg_crc(retreghdr->size))) {
+		return -1;
+	}
+
+	return 0;
+}
+
 /*
  * Tags a register if tracking is enabled in the register
  * interface
@@ -78,16 +170,17 @@ int ddrphy_phyinit_setretreglistbase(unsigned long base)
  */
 int ddrphy_phyinit_trackreg(uint32_t adr)
 {
-	int regindx = 0;
+	uint32_t slot;
 
 	/* Return if tracking is disabled */
 	if (tracken == 0) {
 		return 0;
 	}
 
-	/* Search register address within the array */
-	for (regindx = 0; regindx < numregsaved; regindx++) {
-		if (retreglist[regindx].address == adr) {
+	/* Search register address within the hash index of the array */
+	for (slot = RETREG_HASH(adr); retreghash[slot] != 0U;
+	     slot = (slot + 1U) & (RETREG_HASH_SIZE - 1U)) {
+		if (retreglist[retreghash[slot] - 1U].address == adr) {
 			/* Register found */
 			return 0;
 		}
@@ -101,8 +194,9 @@ int ddrphy_phyinit_trackreg(uint32_t adr)
 		return -1;
 	}
 
-	retreglist[regindx].address = adr;
+	retreglist[numregsaved].address = adr;
 	numregsaved++;
+	retreghash[slot] = (uint16_t)numregsaved;
 
 	return 0;
 }
@@ -157,7 +251,10 @@ int ddrphy_phyinit_reginterface(enum reginstr myreginstr,
 			retreglist[regindx].value = data;
 		}
 
-		*retregsize = numregsaved;
+		retreghdr->size = numregsaved;
+		retreghdr->version = RETREG_VERSION;
+		retreghdr->settings = retreg_settings();
+		retreghdr->crc = retreg_crc(numregsaved);
 
 		return 0;
 	} else if (myreginstr == RESTOREREGS) {
@@ -167,7 +264,7 @@ int ddrphy_phyinit_reginterface(enum reginstr myreginstr,
 		 * write PHY registers based on Address, Data value pairs stores in
 		 * retreglist
 		 */
-		for (regindx = 0; regindx < *retregsize; regindx++) {
+		for (regindx = 0; regindx < retreghdr->size; regindx++) {
 			mmio_write_16((uintptr_t)(DDRPHYC_BASE + 4 * retreglist[regindx].address),
 				      retreglist[regindx].value);
 		}
@@ -28,6 +28,7 @@ int ddrphy_phyinit_sequence(bool skip_training, bool reten)
 	VERBOSE("%s Start\n", __func__);
 
 	/* Initialize structures */
+	HAL_DDR_Trace(HAL_DDR_TRACE_PHY_STAGE, HAL_DDR_TRACE_PHY_ARG('M', 0));
 	ddrphy_phyinit_initstruct();
 
 	/* Re-calculate Firmware Message Block input based on final user input */
@@ -43,6 +44,7 @@ int ddrphy_phyinit_sequence(bool skip_training, bool reten)
 	/* ddrphy_phyinit_usercustom_b_startclockresetphy(); */
 
 	/* (C) Initialize PHY Configuration */
+	HAL_DDR_Trace(HAL_DDR_TRACE_PHY_STAGE, HAL_DDR_TRACE_PHY_ARG('C', 0));
 	ret = ddrphy_phyinit_c_initphyconfig();
 	if (ret != 0) {
 		return ret;
@@ -66,6 +68,7 @@ int ddrphy_phyinit_sequence(bool skip_training, bool reten)
 
 	if (runtimeconfig.skip_train) {
 		/* Skip running training firmware entirely */
+		HAL_DDR_Trace(HAL_DDR_TRACE_PHY_STAGE, HAL_DDR_TRACE_PHY_ARG('S', 0));
 		ddrphy_phyinit_progcsrskiptrain(runtimeconfig.skip_train);
 #ifndef USE_STM32MP257CXX_EMU
 	} else {
@@ -74,6 +77,7 @@ int ddrphy_phyinit_sequence(bool skip_training, bool reten)
 		/* Run all 1D power states, then 2D P0, to reduce total Imem/Dmem loads. */
 
 		/* (D) Load the IMEM Memory for 1D training */
+		HAL_DDR_Trace(HAL_DDR_TRACE_PHY_STAGE, HAL_DDR_TRACE_PHY_ARG('D', 0));
 		ddrphy_phyinit_d_loadimem();
 
 		for (pstate = 0; pstate < userinputbasic.numpstates; pstate++) {
@@ -89,19 +93,22 @@ int ddrphy_phyinit_sequence(bool skip_training, bool reten)
 			 */
 
 			/* (F) Write the Message Block parameters for the training firmware */
+			HAL_DDR_Trace(HAL_DDR_TRACE_PHY_STAGE, HAL_DDR_TRACE_PHY_ARG('F', pstate));
 			ret = ddrphy_phyinit_f_loaddmem(pstate);
 			if (ret != 0) {
 				return ret;
 			}
 
 			/* (G) Execute the Training Firmware */
+			HAL_DDR_Trace(HAL_DDR_TRACE_PHY_STAGE, HAL_DDR_TRACE_PHY_ARG('G', pstate));
 			ret = ddrphy_phyinit_g_execfw();
 			if (ret != 0) {
 				return ret;
 			}
 
 			/* (H) Read the Message Block results */
-			ddrphy_phyinit_h_readmsgblock();
+			HAL_DDR_Trace(HAL_DDR_TRACE_PHY_STAGE, HAL_DDR_TRACE_PHY_ARG('H', pstate));
+			ddrphy_phyinit_h_readmsgblock(pstate);
 		}
 #endif /* !USE_STM32MP257CXX_EMU */
 	}
@@ -113,6 +120,7 @@ int ddrphy_phyinit_sequence(bool skip_training, bool reten)
 	}
 
 	/* (I) Load PHY Init Engine Image */
+	HAL_DDR_Trace(HAL_DDR_TRACE_PHY_STAGE, HAL_DDR_TRACE_PHY_ARG('I', 0));
 	ddrphy_phyinit_i_loadpieimage(runtimeconfig.skip_train);
 
 	/*
@@ -123,6 +131,7 @@ int ddrphy_phyinit_sequence(bool skip_training, bool reten)
 
 	if (reten) {
 		/* Save value of tracked registers for retention restore sequence. */
+		HAL_DDR_Trace(HAL_DDR_TRACE_PHY_STAGE, HAL_DDR_TRACE_PHY_ARG('R', 0));
 		ret = ddrphy_phyinit_usercustom_saveretregs();
 		if (ret != 0) {
 			return ret;
@@ -16,56 +16,16 @@
 #define PHYINIT_DELAY_10US		10U
 #define PHYINIT_TIMEOUT_US_1S		1000000U
 
-static void phyinit_udelay(unsigned long delay_us)
-{
-  __IO uint32_t wait_loop_index = 0U;
-
-  wait_loop_index = (delay_us * (SystemCoreClock / (1000000UL * 2UL)));
-
-  #ifdef USE_STM32MP257CXX_EMU
-  wait_loop_index /= 100;
-  #endif
-
-  while(wait_loop_index != 0UL)
-  {
-    wait_loop_index--;
-  }
-}
-
-static __IO uint32_t phyinit_timeout_init_us(unsigned long timeout_us)
-{
-  __IO uint32_t wait_loop_index = 0U;
-
-  wait_loop_index = timeout_us * (SystemCoreClock / (1000000UL * 2UL));
-
-  #ifdef USE_STM32MP257CXX_EMU
-  wait_loop_index *= 10;
-  #endif
-
-  return wait_loop_index;
-}
-
-static bool phyinit_timeout_elapsed(__IO uint32_t timeout)
-{
-  if (timeout == 0U)
-  {
-    return true;
-  }
-
-  return false;
-}
-
 static int wait_uctwriteprotshadow(bool state)
 {
 	uint16_t read_data;
 	uint16_t value = state ? 1U : 0U;
-	__IO uint32_t timeout = phyinit_timeout_init_us(PHYINIT_TIMEOUT_US_1S);
+	uint64_t timeout = HAL_TimeoutInitUs(PHYINIT_TIMEOUT_US_1S);
 
 	do {
 		read_data = mmio_read_16((uintptr_t)(DDRPHYC_BASE +
 						     (4 * (TAPBONLY | CSR_UCTSHADOWREGS_ADDR))));
-		timeout--;
-		if (phyinit_timeout_elapsed(timeout))
+		if (HAL_IsTimeoutElapsed(timeout) != 0U)
 		{
 			return -1;
 		}
@@ -81,7 +41,7 @@ static int ack_message_receipt(void)
 	/* Acknowledge the receipt of the message */
 	mmio_write_16((uintptr_t)(DDRPHYC_BASE + (4 * (TAPBONLY | CSR_DCTWRITEPROT_ADDR))), 0U);
 
-	phyinit_udelay(PHYINIT_DELAY_1US);
+	HAL_DelayUs(PHYINIT_DELAY_1US);
 
 	ret = wait_uctwriteprotshadow(true);
 	if (ret != 0) {
@@ -91,7 +51,7 @@ static int ack_message_receipt(void)
 	/* Complete the 4-phase protocol */
 	mmio_write_16((uintptr_t)(DDRPHYC_BASE + (4 * (TAPBONLY | CSR_DCTWRITEPROT_ADDR))), 1U);
 
-	phyinit_udelay(PHYINIT_DELAY_1US);
+	HAL_DelayUs(PHYINIT_DELAY_1US);
 
 	return 0;
 }
@@ -183,16 +143,19 @@ int ddrphy_phyinit_usercustom_g_waitfwdone(void)
 		VERBOSE("fw_major_message = %x\n", (unsigned int)fw_major_message);
 
 		if (fw_major_message == FW_MAJ_MSG_START_STREAMING) {
+			/* only stored between the handshakes, recorded at the end */
+			uint32_t arg[HAL_DDR_TRAINING_ARG_MAX];
 			int i;
 			int read_data;
+			int string_index;
 			int stream_len;
 
-			ret = get_streaming_message(&read_data);
+			ret = get_streaming_message(&string_index);
 			if (ret != 0) {
 				return ret;
 			}
 
-			stream_len = read_data & 0xFFFF;
+			stream_len = string_index & 0xFFFF;
 
 			for (i = 0; i < stream_len; i++) {
 				ret = get_streaming_message(&read_data);
@@ -201,12 +164,21 @@ int ddrphy_phyinit_usercustom_g_waitfwdone(void)
 				}
 
 				VERBOSE("streaming message = %x\n", (unsigned int)read_data);
+
+				if (i < (int)HAL_DDR_TRAINING_ARG_MAX) {
+					arg[i] = (uint32_t)read_data;
+				}
 			}
+
+			HAL_DDR_TraceTraining(false, (uint32_t)string_index, arg,
+					      MIN((uint32_t)stream_len, HAL_DDR_TRAINING_ARG_MAX));
+		} else {
+			HAL_DDR_TraceTraining(true, (uint32_t)fw_major_message, NULL, 0U);
 		}
 	} while ((fw_major_message != FW_MAJ_MSG_TRAINING_SUCCESS) &&
 		 (fw_major_message != FW_MAJ_MSG_TRAINING_FAILED));
 
-	phyinit_udelay(PHYINIT_DELAY_10US);
+	HAL_DelayUs(PHYINIT_DELAY_10US);
 
 	if (fw_major_message == FW_MAJ_MSG_TRAINING_FAILED) {
 		ERROR("%s Training has failed.\n", __func__);
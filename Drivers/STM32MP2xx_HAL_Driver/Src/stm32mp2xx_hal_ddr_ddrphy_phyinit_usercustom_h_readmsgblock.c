@@ -4,37 +4,63 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stddef.h>
+
 #include "stm32mp2xx_hal_ddr_ddrphy_phyinit.h"
 
+/* Byte range of the message block from field first to field last */
+#define MSGBLK_RANGE(first, last) \
+	{ offsetof(struct pmu_smb_ddr_1d, first), \
+	  offsetof(struct pmu_smb_ddr_1d, last) + sizeof(((struct pmu_smb_ddr_1d *)0)->last) - 1U }
+
+/* Output fields of the 1D message block, read after the training */
+static const struct {
+	uint16_t first;
+	uint16_t last;
+} msgblk_out[] = {
+	MSGBLK_RANGE(pmurevision, pmurevision),
+	MSGBLK_RANGE(cstestfail, cstestfail),
+#if STM32MP_LPDDR4_TYPE
+	MSGBLK_RANGE(cdd_cha_rr_1_0, cdd_cha_ww_0_1),
+	MSGBLK_RANGE(cdd_chb_rr_1_0, cdd_chb_ww_0_1),
+#else /* STM32MP_LPDDR4_TYPE */
+	MSGBLK_RANGE(cdd_rr_3_2, cdd_wr_0_0),
+#endif /* STM32MP_LPDDR4_TYPE */
+#if STM32MP_DDR4_TYPE
+	/* trained VrefDQ */
+	MSGBLK_RANGE(vrefdqr0nib0, vrefdqr3nib19),
+#endif /* STM32MP_DDR4_TYPE */
+};
+
 /*
  * Reads training results
  *
  * Read the Firmware Message Block via APB read commands to the DMEM address to
  * obtain training results.
  *
- * The default behavior of this function is to print comments relating to this
- * process. An example pseudo code for implementing this function is as follows:
+ * Only the 16-bit DMEM words holding the output fields listed in msgblk_out
+ * are read, into res_ddr_1d[pstate] at the same offsets.
  *
- * @code{.c}
- * {
- *   _read_1d_message_block_outputs_
- * }
- * @endcode
- *
- * A function call of the same name will be printed in the output text file.
- * User can choose to leave this function as is, or implement mechanism to
- * trigger message block read events in simulation.
+ * \param pstate the P-state trained by the firmware
  *
  * \return void
  */
-void ddrphy_phyinit_usercustom_h_readmsgblock(void)
+void ddrphy_phyinit_usercustom_h_readmsgblock(int pstate)
 {
-	VERBOSE(" 2. Read the Firmware Message Block to obtain the results from the training.\n");
-	VERBOSE(" This can be accomplished by issuing APB read commands to the DMEM addresses.\n");
-	VERBOSE(" Example:\n");
-	VERBOSE("   _read_1d_message_block_outputs_\n");
+	uint16_t *res = (uint16_t *)&res_ddr_1d[pstate];
+	unsigned int i;
+	unsigned int word;
 
 	VERBOSE("%s Start\n", __func__);
 
+	for (i = 0U; i < sizeof(msgblk_out) / sizeof(msgblk_out[0]); i++) {
+		for (word = msgblk_out[i].first / 2U; word <= msgblk_out[i].last / 2U; word++) {
+			res[word] = mmio_read_16((uintptr_t)(DDRPHYC_BASE +
+							     (4 * (DMEM_ST_ADDR + word))));
+		}
+	}
+
+	res_ddr_1d_read[pstate] = true;
+
 	VERBOSE("%s End\n", __func__);
 }
@@ -8,6 +8,22 @@
 
 #include "stm32mp2xx_hal_ddr_ddrphy_phyinit.h"
 
+/*
+ * The PHY only uses the lower 16 bits of each 32-bit APB location: the SRAM
+ * is written with a plain 32-bit store per location, which removes the read
+ * of the read-modify-write done by mmio_write_16(). DDRPHYC is mapped as
+ * Device-nGnRnE, so each store still waits for its APB completion.
+ */
+#define WRITEOUT_UNROLL	4
+
+#ifdef USE_STM32MP257CXX_EMU
+#define WRITEOUT_FIRST(data)	((data) >> 16)
+#define WRITEOUT_SECOND(data)	((data) & 0xFFFFU)
+#else /* USE_STM32MP257CXX_EMU */
+#define WRITEOUT_FIRST(data)	((data) & 0xFFFFU)
+#define WRITEOUT_SECOND(data)	((data) >> 16)
+#endif /* USE_STM32MP257CXX_EMU */
+
 /*
  * Writes local memory content into the SRAM via APB interface.
  *
@@ -22,7 +38,10 @@
  */
 void ddrphy_phyinit_writeoutmem(uint32_t *mem, int mem_offset, int mem_size)
 {
+	volatile uint32_t *apb = (volatile uint32_t *)(DDRPHYC_BASE + 4 * mem_offset);
+	int nb = mem_size / (int)sizeof(uint32_t);
 	int index;
+	int i;
 
 	/*
 	 * 1. Enable access to the internal CSRs by setting the MicroContMuxSel CSR to 0.
@@ -30,22 +49,24 @@ void ddrphy_phyinit_writeoutmem(uint32_t *mem, int mem_offset, int mem_size)
 	 */
 	mmio_write_16((uintptr_t)(DDRPHYC_BASE + 4 * (TAPBONLY | CSR_MICROCONTMUXSEL_ADDR)), 0x0U);
 
-	for (index = 0; index < (int)(mem_size / sizeof(uint32_t)); index++) {
+	for (index = 0; index + WRITEOUT_UNROLL <= nb; index += WRITEOUT_UNROLL) {
+		for (i = 0; i < WRITEOUT_UNROLL; i++) {
+			uint32_t data = mem[index + i];
+
+			apb[(index + i) * 2] = WRITEOUT_FIRST(data);
+			apb[(index + i) * 2 + 1] = WRITEOUT_SECOND(data);
+		}
+	}
+
+	for (; index < nb; index++) {
 		uint32_t data = mem[index];
 
-#ifdef USE_STM32MP257CXX_EMU
-		mmio_write_16((uintptr_t)(DDRPHYC_BASE + 4 * ((index * 2) + mem_offset)),
-			     (data >> 16) & 0xFFFFU);
-		mmio_write_16((uintptr_t)(DDRPHYC_BASE + 4 * ((index * 2) + 1 + mem_offset)),
-			     data & 0xFFFFU);
-#else /* USE_STM32MP257CXX_EMU */
-		mmio_write_16((uintptr_t)(DDRPHYC_BASE + 4 * ((index * 2) + mem_offset)),
-			     data & 0xFFFFU);
-		mmio_write_16((uintptr_t)(DDRPHYC_BASE + 4 * ((index * 2) + 1 + mem_offset)),
-			     (data >> 16) & 0xFFFFU);
-#endif /* USE_STM32MP257CXX_EMU */
+		apb[index * 2] = WRITEOUT_FIRST(data);
+		apb[index * 2 + 1] = WRITEOUT_SECOND(data);
 	}
 
+	__DSB();
+
 	/*
 	 * 2. Isolate the APB access from the internal CSRs by setting the MicroContMuxSel CSR to 1.
 	 *    This allows the firmware unrestricted access to the configuration CSRs.
@@ -58,7 +79,10 @@ void ddrphy_phyinit_writeoutmem(uint32_t *mem, int mem_offset, int mem_size)
  */
 void ddrphy_phyinit_writeoutmsgblk(uint16_t *mem, int mem_offset, int mem_size)
 {
+	volatile uint32_t *apb = (volatile uint32_t *)(DDRPHYC_BASE + 4 * mem_offset);
+	int nb = mem_size / (int)sizeof(uint16_t);
 	int index;
+	int i;
 
 	/*
 	 * 1. Enable access to the internal CSRs by setting the MicroContMuxSel CSR to 0.
@@ -67,10 +91,18 @@ void ddrphy_phyinit_writeoutmsgblk(uint16_t *mem, int mem_offset, int mem_size)
 	mmio_write_16((uintptr_t)(DDRPHYC_BASE + 4 * (TAPBONLY | CSR_MICROCONTMUXSEL_ADDR)), 0x0U);
 
 
-	for (index = 0; index < (int)(mem_size / sizeof(uint16_t)); index++) {
-		mmio_write_16((uintptr_t)(DDRPHYC_BASE + 4 * (index + mem_offset)), mem[index]);
+	for (index = 0; index + WRITEOUT_UNROLL <= nb; index += WRITEOUT_UNROLL) {
+		for (i = 0; i < WRITEOUT_UNROLL; i++) {
+			apb[index + i] = mem[index + i];
+		}
+	}
+
+	for (; index < nb; index++) {
+		apb[index] = mem[index];
 	}
 
+	__DSB();
+
 	/*
 	 * 2. Isolate the APB access from the internal CSRs by setting the MicroContMuxSel CSR to 1.
 	 *    This allows the firmware unrestricted access to the configuration CSRs.